@@ -1,6 +1,31 @@
 #include "ConfigLoader.h"
 #include <yaml-cpp/yaml.h>
 #include <iostream>
+#include <algorithm>
+#include <set>
+
+// Część przepisu: mapa nazwa -> ilość albo pojedyncza nazwa (ilość 1)
+static bool readRecipePart(const YAML::Node &node, const std::string &dishName, const char *what,
+                           std::unordered_map<std::string, int> &out) {
+    if (node.IsScalar()) {
+        out[node.as<std::string>()] = 1;
+    } else if (node.IsMap()) {
+        for (const auto &entry: node) {
+            int amount = entry.second.as<int>();
+            if (amount <= 0) {
+                std::cerr << "Danie '" << dishName << "': ilość '" << entry.first.as<std::string>()
+                        << "' musi być dodatnia\n";
+                return false;
+            }
+            out[entry.first.as<std::string>()] += amount;
+        }
+    }
+    if (out.empty()) {
+        std::cerr << "Danie '" << dishName << "' nie ma określonych " << what << "\n";
+        return false;
+    }
+    return true;
+}
 
 bool ConfigLoader::loadFromFile(const std::string &filename) {
     try {
@@ -13,6 +38,11 @@ bool ConfigLoader::loadFromFile(const std::string &filename) {
                 ph.id = phNode["id"].as<int>();
                 ph.name = phNode["name"].as<std::string>();
                 ph.favoriteDish = phNode["favoriteDish"].as<std::string>();
+                if (phNode["zone"]) ph.zone = phNode["zone"].as<int>();
+                if (ph.zone < 0) {
+                    std::cerr << "Filozof '" << ph.name << "': strefa nie może być ujemna\n";
+                    return false;
+                }
                 philosophers.push_back(ph);
             }
         } else {
@@ -28,6 +58,14 @@ bool ConfigLoader::loadFromFile(const std::string &filename) {
                 std::cerr << "Brak 'count' w 'waiters'\n";
                 return false;
             }
+            if (config["waiters"]["maxBatch"]) waiterConfig.maxBatch = config["waiters"]["maxBatch"].as<int>();
+            if (config["waiters"]["itemMs"]) waiterConfig.itemMs = config["waiters"]["itemMs"].as<int>();
+            if (config["waiters"]["helpNeighbours"])
+                waiterConfig.helpNeighbours = config["waiters"]["helpNeighbours"].as<bool>();
+            if (waiterConfig.maxBatch < 1 || waiterConfig.itemMs < 0) {
+                std::cerr << "W 'waiters' maxBatch musi być >= 1, a itemMs >= 0\n";
+                return false;
+            }
         } else {
             std::cerr << "Brak sekcji 'waiters' w pliku konfiguracyjnym\n";
             return false;
@@ -76,10 +114,18 @@ bool ConfigLoader::loadFromFile(const std::string &filename) {
                 const YAML::Node &details = dishNode.second;
 
                 DishConfig dish;
-                dish.ingredient = details["ingredient"].as<std::string>();
-                dish.cutlery = details["cutlery"].as<std::string>();
+                YAML::Node ingredientsNode = details["ingredients"] ? details["ingredients"] : details["ingredient"];
+                if (!readRecipePart(ingredientsNode, dishName, "składników", dish.ingredients) ||
+                    !readRecipePart(details["cutlery"], dishName, "sztućców", dish.cutlery))
+                    return false;
                 dish.cookTimeMs = details["cookTimeMs"].as<int>();
                 dish.price = details["price"].as<double>();
+                if (details["maxBatch"]) dish.maxBatch = details["maxBatch"].as<int>();
+                if (details["batchPortionMs"]) dish.batchPortionMs = details["batchPortionMs"].as<int>();
+                if (dish.maxBatch < 1 || dish.batchPortionMs < 0) {
+                    std::cerr << "Danie '" << dishName << "': maxBatch musi być >= 1, a batchPortionMs >= 0\n";
+                    return false;
+                }
 
                 dishes[dishName] = dish;
             }
@@ -87,6 +133,58 @@ bool ConfigLoader::loadFromFile(const std::string &filename) {
             std::cerr << "Brak sekcji 'dishes' w pliku konfiguracyjnym\n";
             return false;
         }
+
+        // Czasy (opcjonalne)
+        if (config["timing"]) {
+            const YAML::Node &t = config["timing"];
+            if (t["durationSeconds"]) timing.durationSeconds = t["durationSeconds"].as<int>();
+            if (t["dishwasherIntervalMs"]) timing.dishwasherIntervalMs = t["dishwasherIntervalMs"].as<int>();
+            if (t["dishwasherDurationMs"]) timing.dishwasherDurationMs = t["dishwasherDurationMs"].as<int>();
+            if (t["deliveryIntervalMs"]) timing.deliveryIntervalMs = t["deliveryIntervalMs"].as<int>();
+            if (t["timeScale"]) timing.timeScale = t["timeScale"].as<double>();
+        }
+
+        // Planowanie dostaw (opcjonalne)
+        if (config["delivery"]) {
+            const YAML::Node &d = config["delivery"];
+            if (d["policy"]) delivery.policy = d["policy"].as<std::string>();
+            if (d["alpha"]) delivery.alpha = d["alpha"].as<double>();
+            if (d["leadTimeMs"]) delivery.leadTimeMs = d["leadTimeMs"].as<int>();
+            if (d["safetyFactor"]) delivery.safetyFactor = d["safetyFactor"].as<double>();
+            if (delivery.policy != "heuristic" && delivery.policy != "forecast") {
+                std::cerr << "Nieznana polityka dostaw '" << delivery.policy << "' (dozwolone: heuristic, forecast)\n";
+                return false;
+            }
+            if (delivery.alpha <= 0.0 || delivery.alpha > 1.0 || delivery.leadTimeMs < 0 || delivery.safetyFactor < 0.0) {
+                std::cerr << "W 'delivery' alpha musi być w (0, 1], a leadTimeMs i safetyFactor nieujemne\n";
+                return false;
+            }
+        }
+
+        // Zmywarka ciągła (opcjonalna)
+        if (config["dishwasher"]) {
+            const YAML::Node &w = config["dishwasher"];
+            if (w["machines"]) dishwasher.machines = w["machines"].as<int>();
+            if (w["capacity"]) dishwasher.capacity = w["capacity"].as<int>();
+            if (w["cycleMs"]) dishwasher.cycleMs = w["cycleMs"].as<int>();
+            if (w["startThreshold"]) dishwasher.startThreshold = w["startThreshold"].as<int>();
+            if (dishwasher.machines < 0 || dishwasher.capacity < 1 || dishwasher.cycleMs < 1 ||
+                dishwasher.startThreshold < 1) {
+                std::cerr << "W 'dishwasher' machines musi być nieujemne, a capacity, cycleMs i startThreshold dodatnie\n";
+                return false;
+            }
+        }
+
+        // Zapis przebiegu (opcjonalny)
+        if (config["trace"]) {
+            const YAML::Node &t = config["trace"];
+            if (t["file"]) trace.file = t["file"].as<std::string>();
+            if (t["bufferEvents"]) trace.bufferEvents = t["bufferEvents"].as<int>();
+            if (trace.bufferEvents < 1) {
+                std::cerr << "W 'trace' bufferEvents musi być dodatnie\n";
+                return false;
+            }
+        }
     } catch (const YAML::BadFile &e) {
         std::cerr << "Nie można otworzyć pliku: " << e.what() << std::endl;
         return false;
@@ -95,9 +193,30 @@ bool ConfigLoader::loadFromFile(const std::string &filename) {
         return false;
     }
 
+    buildCatalog();
     return true;
 }
 
+void ConfigLoader::buildCatalog() {
+    // Posortowane nazwy: numery zależą tylko od treści konfiguracji
+    std::set<std::string> dishNames, ingredientNames, cutleryNames;
+    for (const auto &[name, dish]: dishes) {
+        dishNames.insert(name);
+        for (const auto &[ingredient, amount]: dish.ingredients) ingredientNames.insert(ingredient);
+        for (const auto &[type, amount]: dish.cutlery) cutleryNames.insert(type);
+    }
+    for (const auto &[name, amount]: pantry.ingredients)
+        ingredientNames.insert(name);
+    for (const auto &[type, amount]: pantry.cutlery)
+        cutleryNames.insert(type);
+
+    auto built = std::make_shared<Catalog>();
+    for (const auto &name: dishNames) built->dishes.intern(name);
+    for (const auto &name: ingredientNames) built->ingredients.intern(name);
+    for (const auto &name: cutleryNames) built->cutlery.intern(name);
+    catalog = std::move(built);
+}
+
 std::vector<PhilosopherConfig> ConfigLoader::getPhilosophers() const {
     return philosophers;
 }
@@ -106,6 +225,10 @@ int ConfigLoader::getWaiterCount() const {
     return waiterCount;
 }
 
+WaiterConfig ConfigLoader::getWaiterConfig() const {
+    return waiterConfig;
+}
+
 std::vector<CookConfig> ConfigLoader::getCooks() const {
     return cooks;
 }
@@ -117,3 +240,92 @@ PantryConfig ConfigLoader::getPantry() const {
 std::unordered_map<std::string, DishConfig> ConfigLoader::getDishes() const {
     return dishes;
 }
+
+TimingConfig ConfigLoader::getTiming() const {
+    return timing;
+}
+
+DeliveryConfig ConfigLoader::getDelivery() const {
+    return delivery;
+}
+
+DishwasherConfig ConfigLoader::getDishwasher() const {
+    return dishwasher;
+}
+
+TraceConfig ConfigLoader::getTrace() const {
+    return trace;
+}
+
+std::shared_ptr<const Catalog> ConfigLoader::getCatalog() const {
+    return catalog;
+}
+
+void ConfigLoader::setWaiterCount(int count) {
+    waiterCount = count;
+}
+
+void ConfigLoader::setWaiterMaxBatch(int maxBatch) {
+    waiterConfig.maxBatch = std::max(1, maxBatch);
+}
+
+void ConfigLoader::setCookCount(int count) {
+    if (count < 0) count = 0;
+    std::vector<CookConfig> resized;
+    int nextId = 0;
+    for (const auto &cook: cooks)
+        nextId = std::max(nextId, cook.id + 1);
+
+    for (int i = 0; i < count; ++i) {
+        if (i < static_cast<int>(cooks.size())) {
+            resized.push_back(cooks[i]);
+            continue;
+        }
+        // Nowi kucharze przejmują specjalności istniejących po kolei
+        CookConfig cook;
+        cook.id = nextId++;
+        cook.specialtyDish = cooks.empty() ? std::string() : cooks[i % cooks.size()].specialtyDish;
+        resized.push_back(cook);
+    }
+    cooks = resized;
+}
+
+void ConfigLoader::setIngredientAmount(const std::string &name, int amount) {
+    pantry.ingredients[name] = amount;
+    if (catalog->ingredients.find(name) < 0) buildCatalog();
+}
+
+void ConfigLoader::setCutleryAmount(const std::string &type, int amount) {
+    pantry.cutlery[type] = amount;
+    if (catalog->cutlery.find(type) < 0) buildCatalog();
+}
+
+bool ConfigLoader::setCookTime(const std::string &dishName, int cookTimeMs) {
+    auto it = dishes.find(dishName);
+    if (it == dishes.end()) return false;
+    it->second.cookTimeMs = cookTimeMs;
+    return true;
+}
+
+void ConfigLoader::setDeliveryLeadTime(int leadTimeMs) {
+    delivery.leadTimeMs = std::max(0, leadTimeMs);
+}
+
+void ConfigLoader::setDishwasherMachines(int machines) {
+    dishwasher.machines = std::max(0, machines);
+}
+
+void ConfigLoader::setDishwasherCapacity(int capacity) {
+    dishwasher.capacity = std::max(1, capacity);
+}
+
+void ConfigLoader::setTraceFile(const std::string &file) {
+    trace.file = file;
+}
+
+bool ConfigLoader::setMaxBatch(const std::string &dishName, int maxBatch) {
+    auto it = dishes.find(dishName);
+    if (it == dishes.end()) return false;
+    it->second.maxBatch = std::max(1, maxBatch);
+    return true;
+}
@@ -5,11 +5,13 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include "catalog.h"
 
 struct PhilosopherConfig {
     int id;
     std::string name;
     std::string favoriteDish;
+    int zone = 0; // strefa sali (opcjonalne 'zone' w YAML)
 };
 
 struct CookConfig {
@@ -17,11 +19,17 @@ struct CookConfig {
     std::string specialtyDish;
 };
 
+// Przepis: nazwa -> ilość na porcję. W YAML 'ingredient: x' / 'cutlery: y' to jedna sztuka,
+// a 'ingredients: {x: 2, z: 1}' / 'cutlery: {y: 1, w: 1}' to pełny przepis.
+// Opcjonalnie 'maxBatch' i 'batchPortionMs': gotowanie do maxBatch porcji naraz
+// w czasie cookTimeMs + batchPortionMs za każdą porcję ponad pierwszą.
 struct DishConfig {
-    std::string ingredient;
-    std::string cutlery;
+    std::unordered_map<std::string, int> ingredients;
+    std::unordered_map<std::string, int> cutlery;
     int cookTimeMs;
     double price;
+    int maxBatch = 1;
+    int batchPortionMs = 0;
 };
 
 struct PantryConfig {
@@ -29,6 +37,53 @@ struct PantryConfig {
     std::unordered_map<std::string, int> cutlery;
 };
 
+// Opcjonalne 'maxBatch' i 'itemMs' w sekcji 'waiters': kelner zbiera na jeden kurs do maxBatch
+// zgłoszeń tego samego rodzaju; droga tam i z powrotem liczy się raz, a każde zgłoszenie
+// ponad pierwsze dokłada itemMs. Kelnerzy dostają strefy po kolei; z 'helpNeighbours'
+// wolny kelner obsługuje też sąsiednie strefy.
+struct WaiterConfig {
+    int maxBatch = 1;
+    int itemMs = 150;
+    bool helpNeighbours = true;
+};
+
+// Sekcja 'delivery' jest opcjonalna: polityka planowania dostaw składników
+// ('heuristic' - dotychczasowa reguła, 'forecast' - prognoza popytu z punktem ponownego zamówienia)
+struct DeliveryConfig {
+    std::string policy = "heuristic";
+    double alpha = 0.3; // wygładzanie prognozy popytu
+    int leadTimeMs = 0; // od zamówienia do dostawy
+    double safetyFactor = 0.5; // zapas bezpieczeństwa jako część prognozowanego popytu
+};
+
+// Sekcja 'dishwasher' jest opcjonalna: zmywarka ciągła z machines maszynami, każda myje naraz
+// do capacity sztućców przez cycleMs i rusza, gdy brudnych jest co najmniej startThreshold
+// (albo gdy któregoś typu zabrakło czystych). machines == 0 to dotychczasowa zmywarka
+// okresowa z 'timing'.
+struct DishwasherConfig {
+    int machines = 0;
+    int capacity = 10;
+    int cycleMs = 1500;
+    int startThreshold = 5;
+};
+
+// Sekcja 'trace' jest opcjonalna: z podanym 'file' symulacja agentowa zapisuje przebieg
+// w formacie Chrome trace (do pliku <file bez .json>_<nr symulacji>.json); bufferEvents to
+// pojemność pierścienia zdarzeń jednego wątku
+struct TraceConfig {
+    std::string file;
+    int bufferEvents = 65536;
+};
+
+// Sekcja 'timing' jest opcjonalna; domyślne wartości odpowiadają dotychczasowym stałym
+struct TimingConfig {
+    int durationSeconds = 600;
+    int dishwasherIntervalMs = 6000;
+    int dishwasherDurationMs = 1500;
+    int deliveryIntervalMs = 20000;
+    double timeScale = 1.0; // > 1 przyspiesza symulację wątkową
+};
+
 class ConfigLoader {
 public:
     ConfigLoader() = default;
@@ -40,18 +95,64 @@ public:
 
     int getWaiterCount() const;
 
+    WaiterConfig getWaiterConfig() const;
+
     std::vector<CookConfig> getCooks() const;
 
     PantryConfig getPantry() const;
 
     std::unordered_map<std::string, DishConfig> getDishes() const;
 
+    TimingConfig getTiming() const;
+
+    DeliveryConfig getDelivery() const;
+
+    DishwasherConfig getDishwasher() const;
+
+    TraceConfig getTrace() const;
+
+    // Numery dań, składników i sztućców (w kolejności alfabetycznej nazw)
+    std::shared_ptr<const Catalog> getCatalog() const;
+
+    // Modyfikacje wczytanej konfiguracji (przeglądy parametrów)
+    void setWaiterCount(int count);
+
+    void setWaiterMaxBatch(int maxBatch);
+
+    void setCookCount(int count);
+
+    void setIngredientAmount(const std::string &name, int amount);
+
+    void setCutleryAmount(const std::string &type, int amount);
+
+    bool setCookTime(const std::string &dishName, int cookTimeMs);
+
+    bool setMaxBatch(const std::string &dishName, int maxBatch);
+
+    void setDeliveryLeadTime(int leadTimeMs);
+
+    void setDishwasherMachines(int machines);
+
+    void setDishwasherCapacity(int capacity);
+
+    // Pusta ścieżka wyłącza zapis przebiegu
+    void setTraceFile(const std::string &file);
+
 private:
     std::vector<PhilosopherConfig> philosophers;
     int waiterCount = 0;
+    WaiterConfig waiterConfig;
     std::vector<CookConfig> cooks;
     PantryConfig pantry;
     std::unordered_map<std::string, DishConfig> dishes;
+    TimingConfig timing;
+    DeliveryConfig delivery;
+    DishwasherConfig dishwasher;
+    TraceConfig trace;
+    std::shared_ptr<const Catalog> catalog = std::make_shared<Catalog>();
+
+    // Nadaje numery wszystkim nazwom z konfiguracji; wołane po wczytaniu i po dodaniu nowych nazw
+    void buildCatalog();
 };
 
 #endif // CONFIGLOADER_H
@@ -0,0 +1,82 @@
+#include "agenttask.h"
+#include <utility>
+
+AgentTask::AgentTask(AgentTask &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {
+}
+
+AgentTask &AgentTask::operator=(AgentTask &&other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+}
+
+AgentTask::~AgentTask() {
+    if (handle) handle.destroy();
+}
+
+void AgentTask::resume() {
+    if (handle && !handle.done()) handle.resume();
+}
+
+bool AgentTask::done() const {
+    return !handle || handle.done();
+}
+
+bool Sleep::await_ready() {
+    if (scheduler) return duration <= Clock::Duration::zero();
+    clock.sleepFor(duration);
+    return true;
+}
+
+void Sleep::await_suspend(std::coroutine_handle<> handle) {
+    // Po zleceniu timera nie dotykamy już obiektu: korutyna może ruszyć na innym wątku
+    scheduler->postAfter(duration, [handle] { handle.resume(); });
+}
+
+bool Signal::Awaiter::await_ready() {
+    std::unique_lock<std::mutex> lock(signal.mutex);
+    if (!signal.isSet && !scheduler) {
+        signal.cv.wait(lock, [this] { return signal.isSet; });
+    }
+    if (!signal.isSet) return false;
+    signal.isSet = false;
+    return true;
+}
+
+bool Signal::Awaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(signal.mutex);
+    if (signal.isSet) {
+        // set() zdążył między await_ready a zawieszeniem
+        signal.isSet = false;
+        return false;
+    }
+    signal.waiter = handle;
+    signal.waiterScheduler = scheduler;
+    return true;
+}
+
+void Signal::set() {
+    std::coroutine_handle<> handle;
+    TaskScheduler *scheduler = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (waiter) {
+            handle = std::exchange(waiter, nullptr);
+            scheduler = std::exchange(waiterScheduler, nullptr);
+        } else {
+            isSet = true;
+        }
+    }
+    if (handle) {
+        scheduler->post([handle] { handle.resume(); });
+    } else {
+        cv.notify_one();
+    }
+}
+
+void Signal::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    isSet = false;
+}
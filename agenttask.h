@@ -0,0 +1,110 @@
+#ifndef AGENTTASK_H
+#define AGENTTASK_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+
+#include "clock.h"
+#include "scheduler.h"
+
+// Korutyna cyklu życia agenta. Startuje zawieszona, ruszają ją start()/resume().
+// Ramka należy do obiektu AgentTask i jest niszczona razem z nim.
+class AgentTask {
+public:
+    struct promise_type {
+        AgentTask get_return_object() {
+            return AgentTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    AgentTask() = default;
+
+    AgentTask(AgentTask &&other) noexcept;
+
+    AgentTask &operator=(AgentTask &&other) noexcept;
+
+    AgentTask(const AgentTask &) = delete;
+
+    AgentTask &operator=(const AgentTask &) = delete;
+
+    ~AgentTask();
+
+    void resume();
+
+    bool done() const;
+
+private:
+    explicit AgentTask(std::coroutine_handle<promise_type> handle) : handle(handle) {
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Czas jako awaitable: bez planisty usypia bieżący wątek (tryb wątek-na-agenta),
+// z planistą zawiesza korutynę i wznawia ją timerem na puli.
+class Sleep {
+public:
+    Sleep(Clock &clock, TaskScheduler *scheduler, Clock::Duration duration)
+        : clock(clock), scheduler(scheduler), duration(duration) {
+    }
+
+    bool await_ready();
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    void await_resume() {
+    }
+
+private:
+    Clock &clock;
+    TaskScheduler *scheduler;
+    Clock::Duration duration;
+};
+
+// Jednorazowe powiadomienie dla jednego oczekującego (kasuje się po odebraniu).
+// Oczekujący blokuje wątek albo, z planistą, zawiesza korutynę do set().
+class Signal {
+public:
+    class Awaiter {
+    public:
+        Awaiter(Signal &signal, TaskScheduler *scheduler) : signal(signal), scheduler(scheduler) {
+        }
+
+        bool await_ready();
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() {
+        }
+
+    private:
+        Signal &signal;
+        TaskScheduler *scheduler;
+    };
+
+    Awaiter wait(TaskScheduler *scheduler) { return Awaiter(*this, scheduler); }
+
+    void set();
+
+    void reset();
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool isSet = false;
+    std::coroutine_handle<> waiter;
+    TaskScheduler *waiterScheduler = nullptr;
+};
+
+#endif // AGENTTASK_H
@@ -0,0 +1,131 @@
+// Mikrobenchmarki gorących ścieżek kuchni: każdy przypadek na 1, 2, 4, ... maxThreads wątkach.
+// Uruchomienie: Filozofowie_benchmark [maxThreads] [opsPerThread]
+#include "kitchen.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Zasobów tyle, że żadna rezerwacja w benchmarku nie zabraknie i nic nie parkuje
+    constexpr int unlimited = 1 << 30;
+
+    struct BenchKitchen {
+        std::shared_ptr<Kitchen> kitchen;
+        DishId dish = -1;
+    };
+
+    // Danie z dwoma składnikami i jednym sztućcem, po jednym kucharzu na wątek
+    BenchKitchen makeKitchen(int cooks) {
+        auto catalog = std::make_shared<Catalog>();
+        DishId dish = catalog->dishes.intern("bigos");
+        IngredientId cabbage = catalog->ingredients.intern("kapusta");
+        IngredientId meat = catalog->ingredients.intern("mieso");
+        CutleryId fork = catalog->cutlery.intern("widelec");
+
+        auto kitchen = std::make_shared<Kitchen>(catalog);
+        kitchen->addIngredient(cabbage, unlimited);
+        kitchen->addIngredient(meat, unlimited);
+        kitchen->addCutlery(fork, unlimited);
+        kitchen->addDish(dish, Kitchen::DishInfo{{{cabbage, 1}, {meat, 1}}, {{fork, 1}}, 1000, 10.0});
+        for (int i = 0; i < cooks; ++i)
+            kitchen->registerCook(dish);
+        return BenchKitchen{kitchen, dish};
+    }
+
+    // Jedna operacja wątku thread; zwraca, czy się udała (do kontroli poprawności)
+    using Operation = std::function<bool(BenchKitchen &bench, int thread)>;
+
+    struct Case {
+        std::string name;
+        Operation operation;
+    };
+
+    struct Measurement {
+        double seconds;
+        long long ops;
+        long long succeeded;
+    };
+
+    Measurement measure(const Operation &operation, int threads, long long opsPerThread) {
+        BenchKitchen bench = makeKitchen(threads);
+        std::latch ready(threads + 1);
+        std::vector<long long> succeeded(threads, 0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                ready.arrive_and_wait();
+                long long ok = 0;
+                for (long long i = 0; i < opsPerThread; ++i)
+                    ok += operation(bench, t) ? 1 : 0;
+                succeeded[t] = ok;
+            });
+        }
+
+        ready.arrive_and_wait();
+        auto start = std::chrono::steady_clock::now();
+        for (auto &worker: workers)
+            worker.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long long ok = 0;
+        for (long long count: succeeded) ok += count;
+        return Measurement{seconds, opsPerThread * threads, ok};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    long long opsPerThread = 200000;
+    if (argc >= 2) maxThreads = std::max(1, std::stoi(argv[1]));
+    if (argc >= 3) opsPerThread = std::max(1LL, std::stoll(argv[2]));
+
+    const ServiceArea wholeRoom{{0}, {}};
+    std::vector<Case> cases = {
+        // Kelner oddaje zamówienie, kucharz od razu bierze partię (z rezerwacją zasobów)
+        {"addOrder+takeCookableBatch", [](BenchKitchen &bench, int thread) {
+            bench.kitchen->addOrder(thread, bench.dish);
+            return bench.kitchen->takeCookableBatch(thread).has_value();
+        }},
+        {"canPrepare+reserveResourcesFor", [](BenchKitchen &bench, int) {
+            return bench.kitchen->canPrepare(bench.dish) && bench.kitchen->reserveResourcesFor(bench.dish);
+        }},
+        // Gotowe danie do kolejki kelnerów i odbiór przez kelnera
+        {"markDishReady+tryPop", [&wholeRoom](BenchKitchen &bench, int thread) {
+            bench.kitchen->markDishReady(Kitchen::Order{thread, bench.dish, OrderTimes()});
+            return bench.kitchen->getServiceQueue().tryPop(wholeRoom).has_value();
+        }},
+        {"getMenu+find", [](BenchKitchen &bench, int) {
+            return bench.kitchen->getMenu()->find(bench.dish) != nullptr;
+        }},
+    };
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << std::left << std::setw(34) << "przypadek" << std::right << std::setw(8) << "watki"
+            << std::setw(16) << "ops/s" << std::setw(12) << "ns/op" << std::setw(10) << "udane" << "\n";
+    for (const auto &benchCase: cases) {
+        for (int threads: threadCounts) {
+            Measurement m = measure(benchCase.operation, threads, opsPerThread);
+            // ns/op: średni czas jednej operacji widziany przez wątek
+            double opsPerSecond = m.ops / m.seconds;
+            double nsPerOp = m.seconds * 1e9 * threads / m.ops;
+            std::cout << std::left << std::setw(34) << benchCase.name << std::right << std::setw(8) << threads
+                    << std::setw(16) << std::fixed << std::setprecision(0) << opsPerSecond
+                    << std::setw(12) << std::setprecision(1) << nsPerOp
+                    << std::setw(9) << std::setprecision(1) << 100.0 * m.succeeded / m.ops << "%\n";
+        }
+    }
+    LockProfiler::report(std::cout); // tylko z PROFILE_LOCKS
+    return 0;
+}
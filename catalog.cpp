@@ -0,0 +1,18 @@
+#include "catalog.h"
+
+int NameTable::intern(const std::string &name) {
+    auto [it, inserted] = ids.try_emplace(name, static_cast<int>(names.size()));
+    if (inserted) names.push_back(name);
+    return it->second;
+}
+
+int NameTable::find(const std::string &name) const {
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : -1;
+}
+
+const std::string &NameTable::name(int id) const {
+    static const std::string unknown;
+    if (id < 0 || id >= size()) return unknown;
+    return names[id];
+}
@@ -0,0 +1,38 @@
+#ifndef CATALOG_H
+#define CATALOG_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Zwarte numery nadawane przy wczytywaniu konfiguracji; w kuchni i kolejkach krążą
+// tylko one, a nazwy są potrzebne dopiero do wyświetlania i raportów
+using DishId = int;
+using IngredientId = int;
+using CutleryId = int;
+
+class NameTable {
+public:
+    // Zwraca numer nazwy, w razie potrzeby nadaje kolejny
+    int intern(const std::string &name);
+
+    // -1, gdy nazwy nie ma w tabeli
+    int find(const std::string &name) const;
+
+    // Pusty napis dla nieznanego numeru
+    const std::string &name(int id) const;
+
+    int size() const { return static_cast<int>(names.size()); }
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> ids;
+};
+
+struct Catalog {
+    NameTable dishes;
+    NameTable ingredients;
+    NameTable cutlery;
+};
+
+#endif // CATALOG_H
@@ -0,0 +1,76 @@
+#include "clock.h"
+#include <thread>
+
+RealClock::RealClock() : start(std::chrono::steady_clock::now()) {
+}
+
+Clock::Duration RealClock::now() const {
+    return std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start);
+}
+
+void RealClock::sleepFor(Duration duration) {
+    std::this_thread::sleep_for(duration);
+}
+
+ScaledClock::ScaledClock(double factor)
+    : start(std::chrono::steady_clock::now()), factor(factor > 0.0 ? factor : 1.0) {
+}
+
+Clock::Duration ScaledClock::now() const {
+    return std::chrono::duration_cast<Duration>((std::chrono::steady_clock::now() - start) * factor);
+}
+
+void ScaledClock::sleepFor(Duration duration) {
+    std::this_thread::sleep_for(toRealTime(duration));
+}
+
+std::chrono::nanoseconds ScaledClock::toRealTime(Duration duration) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration / factor);
+}
+
+Clock::Duration ManualClock::now() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current;
+}
+
+void ManualClock::sleepFor(Duration duration) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Duration deadline = current + duration;
+    auto it = deadlines.insert(deadline);
+    cv.wait(lock, [this, deadline] { return current >= deadline || released; });
+    deadlines.erase(it);
+}
+
+void ManualClock::advance(Duration duration) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current += duration;
+    }
+    cv.notify_all();
+}
+
+void ManualClock::advanceTo(Duration time) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (time > current) current = time;
+    }
+    cv.notify_all();
+}
+
+bool ManualClock::step() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (deadlines.empty()) return false;
+        if (*deadlines.begin() > current) current = *deadlines.begin();
+    }
+    cv.notify_all();
+    return true;
+}
+
+void ManualClock::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    cv.notify_all();
+}
@@ -0,0 +1,95 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
+// Zegar symulacji wspólny dla wszystkich agentów.
+// now() zwraca czas symulacji liczony od utworzenia zegara.
+class Clock {
+public:
+    using Duration = std::chrono::microseconds;
+
+    virtual ~Clock() = default;
+
+    virtual Duration now() const = 0;
+
+    virtual void sleepFor(Duration duration) = 0;
+
+    void sleepForMs(int ms) { sleepFor(std::chrono::milliseconds(ms)); }
+
+    // Ile czasu rzeczywistego odpowiada podanemu odcinkowi czasu symulacji
+    virtual std::chrono::nanoseconds toRealTime(Duration duration) const { return duration; }
+
+    // Czas symulacji w pełnych milisekundach (znaczniki etapów zamówienia)
+    long long nowMs() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(now()).count();
+    }
+
+    // Sekundy czasu symulacji, które upłynęły od podanego momentu
+    double secondsSince(Duration start) const {
+        return std::chrono::duration<double>(now() - start).count();
+    }
+};
+
+// Zwykły czas rzeczywisty (steady_clock)
+class RealClock : public Clock {
+public:
+    RealClock();
+
+    Duration now() const override;
+
+    void sleepFor(Duration duration) override;
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Czas przyspieszony: factor = 50 oznacza, że 1 s rzeczywista to 50 s symulacji
+class ScaledClock : public Clock {
+public:
+    explicit ScaledClock(double factor);
+
+    Duration now() const override;
+
+    void sleepFor(Duration duration) override;
+
+    std::chrono::nanoseconds toRealTime(Duration duration) const override;
+
+    double getFactor() const { return factor; }
+
+private:
+    std::chrono::steady_clock::time_point start;
+    double factor;
+};
+
+// Zegar sterowany ręcznie: czas stoi, dopóki ktoś nie wywoła advance()/step().
+// Wątki w sleepFor() czekają, aż czas symulacji dojdzie do ich terminu.
+// Planista M:N odmierza terminy w czasie rzeczywistym (toRealTime), więc z tym zegarem nie startuje.
+class ManualClock : public Clock {
+public:
+    Duration now() const override;
+
+    void sleepFor(Duration duration) override;
+
+    void advance(Duration duration);
+
+    void advanceTo(Duration time);
+
+    // Przesuwa czas do najbliższego terminu śpiącego wątku; false, jeśli nikt nie śpi
+    bool step();
+
+    // Budzi wszystkich śpiących bez przesuwania czasu (np. przy zamykaniu symulacji)
+    void release();
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    Duration current{0};
+    std::multiset<Duration> deadlines;
+    bool released = false;
+};
+
+#endif // CLOCK_H
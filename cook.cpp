@@ -3,13 +3,16 @@
 #include <thread>
 #include <chrono>
 
-Cook::Cook(int id, const std::string &specialtyDish, Kitchen *kitchen)
-    : id(id), specialtyDish(specialtyDish), kitchen(kitchen), state(State::Free) {
+Cook::Cook(int id, int queue, DishId specialtyDish, Kitchen *kitchen, std::shared_ptr<Clock> clock)
+    : id(id), queue(queue), specialtyDish(specialtyDish), kitchen(kitchen), clock(clock), state(State::Free) {
 }
 
 void Cook::start() {
     running = true;
-    thread = std::thread(&Cook::lifeCycle, this);
+    thread = std::thread([this] {
+        task = lifeCycle();
+        task.resume();
+    });
 }
 
 void Cook::join() {
@@ -23,58 +26,75 @@ void Cook::stop() {
     join();
 }
 
-void Cook::lifeCycle() {
-    while (running) {
-        std::optional<Kitchen::Order> orderToProcess;
-
-        // Próbujemy znaleźć możliwe do wykonania zamówienie
-        for (int i = 0; i < 10; ++i) {
-            // sprawdzamy max 10 zamówień z kolejki
-            auto maybeOrder = kitchen->getNextOrder();
-            if (!maybeOrder) {
-                break; // kolejka pusta
-            }
-
-            if (kitchen->canPrepare(maybeOrder->dishName)) {
-                orderToProcess = maybeOrder; // mamy zamówienie do wykonania
-                break;
-            } else {
-                // Odkładamy niewykonalne zamówienie na koniec
-                kitchen->addOrder(maybeOrder->philosopherId, maybeOrder->dishName);
-            }
-        }
-
-        if (orderToProcess) {
-            state = State::Busy;
-            cookOrder(orderToProcess->philosopherId, orderToProcess->dishName);
-            state = State::Free;
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-    }
+void Cook::startTask(TaskScheduler *taskScheduler) {
+    running = true;
+    scheduler = taskScheduler;
+    task = lifeCycle();
+    scheduler->post([this] { task.resume(); });
 }
 
+void Cook::setTracer(Tracer *tracer) {
+    this->tracer = tracer;
+}
 
-void Cook::cookOrder(int philosopherId, const std::string &dishName) {
-    if (!kitchen->reserveResourcesFor(dishName)) {
-        std::cerr << "[COOK " << id << "] Failed to reserve resources for " << dishName << ", retrying later\n";
-
-        // Odkładamy zamówienie z powrotem do kolejki
-        kitchen->addOrder(philosopherId, dishName);
+void Cook::setState(State newState, const char *traceName) {
+    state = newState;
+    if (tracer) tracer->state(Tracer::cookTrack(id), traceName, clock->now().count());
+}
 
-        // Czekamy chwilę, by nie zalać kolejki natychmiast
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        return;
+AgentTask Cook::lifeCycle() {
+    setState(State::Free, "Free");
+    while (running) {
+        // Kuchnia oddaje tylko zamówienia z zarezerwowanymi zasobami; reszta czeka zaparkowana.
+        // Najpierw własna kolejka (dania specjalności), potem kradzież od innych kucharzy.
+        // Bez pracy kucharz parkuje do nowego zamówienia lub uzupełnienia zasobów, bez odpytywania.
+        auto batch = co_await kitchen->nextCookableBatch(scheduler, queue);
+        if (!batch) break; // kuchnia zamknięta, koniec symulacji
+
+        // cookOrder
+        setState(State::Busy, kitchen->getCatalog().dishes.name(batch->front().dishId).c_str());
+        long long startMs = clock->nowMs();
+        for (auto &order: *batch)
+            order.times.mark(OrderStage::CookStarted, startMs);
+        int cookingTime = startCooking(*batch);
+        co_await sleepMs(cookingTime);
+        finishCooking(*batch);
+        setState(State::Free, "Free");
     }
+}
+
+Sleep Cook::sleepMs(int ms) {
+    return Sleep(*clock, scheduler, std::chrono::milliseconds(ms));
+}
 
+// Partia na jedno danie, np. "2x bigos for philosophers 3 7"
+static void printBatch(std::ostream &out, const Kitchen &kitchen, const Kitchen::Batch &batch) {
+    if (batch.size() > 1) out << batch.size() << "x ";
+    out << kitchen.getCatalog().dishes.name(batch.front().dishId)
+            << (batch.size() > 1 ? " for philosophers" : " for philosopher");
+    for (const auto &order: batch)
+        out << " " << order.philosopherId;
+    out << "\n";
+}
 
-    int baseTime = kitchen->getCookingTime(dishName);
-    int cookingTime = (dishName == specialtyDish) ? static_cast<int>(baseTime * 0.6) : baseTime;
+int Cook::startCooking(const Kitchen::Batch &batch) {
+    DishId dish = batch.front().dishId;
+    int baseTime = kitchen->getCookingTime(dish, static_cast<int>(batch.size()));
+    int cookingTime = (dish == specialtyDish) ? static_cast<int>(baseTime * 0.6) : baseTime;
 
-    std::cout << "[COOK " << id << "] Cooking " << dishName << " for philosopher " << philosopherId << "\n";
-    std::this_thread::sleep_for(std::chrono::milliseconds(cookingTime));
-    kitchen->markDishReady(philosopherId, dishName);
-    std::cout << "[COOK " << id << "] Finished " << dishName << " for philosopher " << philosopherId << "\n";
+    std::cout << "[COOK " << id << "] Cooking ";
+    printBatch(std::cout, *kitchen, batch);
+    return cookingTime;
+}
+
+void Cook::finishCooking(const Kitchen::Batch &batch) {
+    long long readyMs = clock->nowMs();
+    for (Kitchen::Order order: batch) {
+        order.times.mark(OrderStage::Ready, readyMs);
+        kitchen->markDishReady(order);
+    }
+    std::cout << "[COOK " << id << "] Finished ";
+    printBatch(std::cout, *kitchen, batch);
 }
 
 Cook::State Cook::getState() {
@@ -4,7 +4,12 @@
 #include <string>
 #include <thread>
 #include <atomic>
+#include <memory>
 #include "kitchen.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "agenttask.h"
+#include "tracer.h"
 
 class Cook {
 public:
@@ -13,7 +18,8 @@ public:
         Busy
     };
 
-    Cook(int id, const std::string &specialtyDish, Kitchen *kitchen);
+    // queue: numer kolejki z Kitchen::registerCook
+    Cook(int id, int queue, DishId specialtyDish, Kitchen *kitchen, std::shared_ptr<Clock> clock);
 
     void start();
 
@@ -21,21 +27,42 @@ public:
 
     void stop();
 
+    // Tryb M:N: korutyna kucharza wznawiana na puli planisty zamiast na własnym wątku
+    void startTask(TaskScheduler *taskScheduler);
+
     State getState();
 
+    // Zmiany stanu trafiają do zapisu przebiegu; tylko przed startem
+    void setTracer(Tracer *tracer);
+
     int getId() const;
 
     int id;
+    int queue;
     std::atomic<bool> running;
-    std::string specialtyDish;
+    DishId specialtyDish;
     Kitchen *kitchen;
+    std::shared_ptr<Clock> clock;
 
     std::thread thread;
     std::atomic<State> state = State::Free;
 
-    void lifeCycle();
+    TaskScheduler *scheduler = nullptr; // nullptr = własny wątek
+    AgentTask task;
+    Tracer *tracer = nullptr;
+
+    AgentTask lifeCycle();
+
+    // traceName: w zapisie przebiegu gotowane danie zamiast samego "Busy"
+    void setState(State newState, const char *traceName);
+
+    Sleep sleepMs(int ms);
+
+    // Zasoby są już zarezerwowane przez Kitchen::takeCookableBatch; zwraca czas gotowania partii w ms
+    int startCooking(const Kitchen::Batch &batch);
 
-    void cookOrder(int philosopherId, const std::string &dishName);
+    // Wszystkie porcje partii trafiają do kelnerów naraz
+    void finishCooking(const Kitchen::Batch &batch);
 };
 
 #endif // COOK_H
@@ -0,0 +1,92 @@
+#include "deliveryplanner.h"
+#include <algorithm>
+#include <cmath>
+
+DeliveryPlanner::DeliveryPlanner(int ingredientCount) : ingredientCount(ingredientCount), demand(ingredientCount) {
+}
+
+void DeliveryPlanner::recordDemand(IngredientId ingredient, int amount) {
+    if (ingredient < 0 || ingredient >= ingredientCount) return;
+    demand.add(ingredient, amount);
+}
+
+std::vector<int> DeliveryPlanner::takeDemand() {
+    std::vector<int> observed(ingredientCount);
+    for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient)
+        observed[ingredient] = demand.takeAll(ingredient);
+    return observed;
+}
+
+HeuristicPlanner::HeuristicPlanner(int ingredientCount)
+    : DeliveryPlanner(ingredientCount), plannedAmount(ingredientCount, 0) {
+}
+
+std::vector<int> HeuristicPlanner::deliver(const std::vector<int> &stock) {
+    takeDemand(); // reguła nie patrzy na popyt
+    for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient) {
+        int &planned = plannedAmount[ingredient];
+        if (planned == 0) planned = 5;
+        if (stock[ingredient] == 0) {
+            planned += 2;
+        } else if (stock[ingredient] > planned) {
+            planned = std::max(1, planned - 1);
+        }
+    }
+    return plannedAmount;
+}
+
+ForecastPlanner::ForecastPlanner(int ingredientCount, int intervalMs, double alpha, int leadTimeMs,
+                                 double safetyFactor)
+    : DeliveryPlanner(ingredientCount), alpha(alpha),
+      leadCycles(intervalMs > 0 ? (std::max(0, leadTimeMs) + intervalMs - 1) / intervalMs : 0),
+      safetyFactor(safetyFactor), demandRate(ingredientCount, 0.0), onOrder(ingredientCount, 0) {
+}
+
+std::vector<int> ForecastPlanner::deliver(const std::vector<int> &stock) {
+    ++cycle;
+    std::vector<int> arriving(ingredientCount, 0);
+    while (!pending.empty() && pending.front().dueCycle <= cycle) {
+        for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient) {
+            arriving[ingredient] += pending.front().amounts[ingredient];
+            onOrder[ingredient] -= pending.front().amounts[ingredient];
+        }
+        pending.pop_front();
+    }
+
+    // Pierwszy cykl ustawia prognozę wprost, kolejne wygładzają
+    std::vector<int> observed = takeDemand();
+    for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient) {
+        double &rate = demandRate[ingredient];
+        rate = hasEstimate ? alpha * observed[ingredient] + (1.0 - alpha) * rate : observed[ingredient];
+    }
+    hasEstimate = true;
+
+    std::vector<int> ordered(ingredientCount, 0);
+    for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient) {
+        double rate = demandRate[ingredient];
+        double reorderPoint = rate * (leadCycles + 1) * (1.0 + safetyFactor);
+        int position = stock[ingredient] + arriving[ingredient] + onOrder[ingredient];
+        if (position <= reorderPoint)
+            ordered[ingredient] = static_cast<int>(std::ceil(reorderPoint + rate - position));
+    }
+
+    if (leadCycles == 0) {
+        for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient)
+            arriving[ingredient] += ordered[ingredient];
+    } else {
+        for (IngredientId ingredient = 0; ingredient < ingredientCount; ++ingredient)
+            onOrder[ingredient] += ordered[ingredient];
+        pending.push_back(PendingDelivery{cycle + leadCycles, std::move(ordered)});
+    }
+    return arriving;
+}
+
+std::unique_ptr<DeliveryPlanner> makeDeliveryPlanner(const DeliveryConfig &config, int ingredientCount,
+                                                     int intervalMs) {
+    if (config.policy == "heuristic")
+        return std::make_unique<HeuristicPlanner>(ingredientCount);
+    if (config.policy == "forecast")
+        return std::make_unique<ForecastPlanner>(ingredientCount, intervalMs, config.alpha, config.leadTimeMs,
+                                                 config.safetyFactor);
+    return nullptr;
+}
@@ -0,0 +1,77 @@
+#ifndef DELIVERYPLANNER_H
+#define DELIVERYPLANNER_H
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "ConfigLoader.h"
+#include "catalog.h"
+#include "resourcestore.h"
+
+// Planowanie dostaw składników. Kelnerzy zgłaszają popyt z każdego przyjętego zamówienia,
+// a cykl dostaw pyta planistę, ile czego przywieźć. Polityki są wymienne, żeby je porównywać.
+class DeliveryPlanner {
+public:
+    explicit DeliveryPlanner(int ingredientCount);
+
+    virtual ~DeliveryPlanner() = default;
+
+    // Popyt z przyjętego zamówienia; bez blokad, wołane współbieżnie
+    void recordDemand(IngredientId ingredient, int amount);
+
+    // Jeden cykl dostaw: stan spiżarni -> ilości przywiezione teraz (indeks = IngredientId).
+    // Wołane tylko z jednego wątku naraz.
+    virtual std::vector<int> deliver(const std::vector<int> &stock) = 0;
+
+protected:
+    // Popyt od poprzedniego cyklu; zeruje liczniki
+    std::vector<int> takeDemand();
+
+    int ingredientCount;
+
+private:
+    ResourceStore demand;
+};
+
+// Dotychczasowa reguła: plan startuje od 5, +2 gdy składnika zabrakło, -1 gdy zostało więcej niż plan
+class HeuristicPlanner : public DeliveryPlanner {
+public:
+    explicit HeuristicPlanner(int ingredientCount);
+
+    std::vector<int> deliver(const std::vector<int> &stock) override;
+
+private:
+    std::vector<int> plannedAmount;
+};
+
+// Prognoza popytu (EWMA na cykl dostaw) i punkt ponownego zamówienia. Zamówienie złożone
+// w cyklu przychodzi po leadTimeMs (zaokrąglonym w górę do cykli). Gdy zapas wraz z zamówionym
+// spadnie do punktu R = popyt * (czas dostawy + cykl) * (1 + safetyFactor), zamawiamy do R + popyt na cykl.
+class ForecastPlanner : public DeliveryPlanner {
+public:
+    ForecastPlanner(int ingredientCount, int intervalMs, double alpha, int leadTimeMs, double safetyFactor);
+
+    std::vector<int> deliver(const std::vector<int> &stock) override;
+
+private:
+    struct PendingDelivery {
+        long long dueCycle;
+        std::vector<int> amounts;
+    };
+
+    double alpha;
+    int leadCycles;
+    double safetyFactor;
+    long long cycle = 0;
+    bool hasEstimate = false;
+    std::vector<double> demandRate; // sztuk na cykl
+    std::vector<int> onOrder;
+    std::deque<PendingDelivery> pending;
+};
+
+// Polityka z konfiguracji; nullptr dla nieznanej nazwy
+std::unique_ptr<DeliveryPlanner> makeDeliveryPlanner(const DeliveryConfig &config, int ingredientCount,
+                                                     int intervalMs);
+
+#endif // DELIVERYPLANNER_H
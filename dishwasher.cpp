@@ -0,0 +1,71 @@
+#include "dishwasher.h"
+
+Dishwasher::Dishwasher(const DishwasherConfig &config, ResourceStore &dirty, ResourceStore &clean, Timer timer,
+                       OnWashed onWashed)
+    : config(config), dirty(dirty), clean(clean), timer(std::move(timer)), onWashed(std::move(onWashed)) {
+}
+
+void Dishwasher::poke() {
+    // Szybka ścieżka przy każdym zwrocie sztućców: wszystkie maszyny zajęte
+    if (stopped || busyMachines.load(std::memory_order_acquire) >= config.machines) return;
+
+    std::vector<Load> started;
+    {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+        Load load;
+        while (busyMachines.load(std::memory_order_relaxed) < config.machines && tryLoad(load)) {
+            busyMachines.fetch_add(1, std::memory_order_acq_rel);
+            started.push_back(std::move(load));
+        }
+    }
+    for (auto &load: started)
+        timer(config.cycleMs, [this, load = std::move(load)] { finishCycle(load); });
+}
+
+bool Dishwasher::tryLoad(Load &load) {
+    int types = dirty.size();
+    int dirtyTotal = 0;
+    bool starving = false;
+    for (CutleryId type = 0; type < types; ++type) {
+        int amount = dirty.get(type);
+        dirtyTotal += amount;
+        if (amount > 0 && clean.get(type) == 0) starving = true;
+    }
+    if (dirtyTotal == 0 || (dirtyTotal < config.startThreshold && !starving)) return false;
+
+    // Po jednej sztuce z każdego typu na zmianę, aż do pojemności maszyny
+    load.amounts.assign(types, 0);
+    int loaded = 0;
+    bool progress = true;
+    while (loaded < config.capacity && progress) {
+        progress = false;
+        for (int i = 0; i < types && loaded < config.capacity; ++i) {
+            CutleryId type = (nextType + i) % types;
+            if (dirty.tryTake(type)) {
+                ++load.amounts[type];
+                ++loaded;
+                progress = true;
+            }
+        }
+    }
+    nextType = types > 0 ? (nextType + 1) % types : 0;
+    return loaded > 0;
+}
+
+void Dishwasher::finishCycle(const Load &load) {
+    if (stopped) return;
+
+    std::vector<CutleryId> washed;
+    for (CutleryId type = 0; type < static_cast<int>(load.amounts.size()); ++type) {
+        if (load.amounts[type] == 0) continue;
+        clean.add(type, load.amounts[type]);
+        washed.push_back(type);
+    }
+    busyMachines.fetch_sub(1, std::memory_order_acq_rel);
+    onWashed(washed);
+    poke(); // zwolniona maszyna od razu bierze kolejny wsad
+}
+
+void Dishwasher::stop() {
+    stopped = true;
+}
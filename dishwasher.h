@@ -0,0 +1,54 @@
+#ifndef DISHWASHER_H
+#define DISHWASHER_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "ConfigLoader.h"
+#include "catalog.h"
+#include "profiledmutex.h"
+#include "resourcestore.h"
+
+// Zmywarka ciągła: kilka maszyn, każda myje naraz do capacity sztućców przez cycleMs.
+// Wolna maszyna rusza, gdy brudnych zbierze się startThreshold albo gdy któregoś typu
+// zabrakło czystych. Po cyklu umyte sztućce od razu wracają do czystych.
+class Dishwasher {
+public:
+    // Odmierzanie czasu zależy od trybu symulacji (timer planisty, kalendarz zdarzeń)
+    using Timer = std::function<void(int delayMs, std::function<void()> action)>;
+    using OnWashed = std::function<void(const std::vector<CutleryId> &types)>;
+
+    Dishwasher(const DishwasherConfig &config, ResourceStore &dirty, ResourceStore &clean, Timer timer,
+               OnWashed onWashed);
+
+    // Przybyło brudnych albo kucharz czeka na sztućce; może uruchomić wolne maszyny
+    void poke();
+
+    // Przerwane cykle nie oddają już sztućców
+    void stop();
+
+private:
+    struct Load {
+        std::vector<int> amounts; // indeks = CutleryId
+    };
+
+    // Wymaga mutex: ładuje maszynę, jeśli jest po co
+    bool tryLoad(Load &load);
+
+    void finishCycle(const Load &load);
+
+    DishwasherConfig config;
+    ResourceStore &dirty;
+    ResourceStore &clean;
+    Timer timer;
+    OnWashed onWashed;
+
+    ProfiledMutex mutex{"dishwasher"};
+    std::atomic<int> busyMachines = 0;
+    std::atomic<bool> stopped = false;
+    CutleryId nextType = 0; // pod mutex: od którego typu zaczyna ładowanie, żeby żaden nie czekał
+};
+
+#endif // DISHWASHER_H
@@ -3,6 +3,7 @@
 #include <iomanip>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 Display::Display(const std::vector<Philosopher *> &philosophers,
                  const std::vector<Waiter *> &waiters,
@@ -92,21 +93,18 @@ void Display::show() {
 
     const auto &pantry = kitchen->getPantry();
     const auto &cutlery = kitchen->getCutleryStock();
+    const Catalog &catalog = kitchen->getCatalog();
 
-    auto panIt = pantry.begin();
-    auto cutIt = cutlery.begin();
-
-    while (panIt != pantry.end() || cutIt != cutlery.end()) {
-        if (panIt != pantry.end()) {
-            std::cout << std::setw(20) << panIt->first << std::setw(10) << panIt->second;
-            ++panIt;
+    size_t rows = std::max(pantry.size(), cutlery.size());
+    for (size_t i = 0; i < rows; ++i) {
+        if (i < pantry.size()) {
+            std::cout << std::setw(20) << catalog.ingredients.name(static_cast<int>(i)) << std::setw(10) << pantry[i];
         } else {
             std::cout << std::setw(30) << " ";
         }
 
-        if (cutIt != cutlery.end()) {
-            std::cout << std::setw(20) << cutIt->first << std::setw(10) << cutIt->second;
-            ++cutIt;
+        if (i < cutlery.size()) {
+            std::cout << std::setw(20) << catalog.cutlery.name(static_cast<int>(i)) << std::setw(10) << cutlery[i];
         }
         std::cout << "\n";
     }
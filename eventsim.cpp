@@ -0,0 +1,259 @@
+#include "eventsim.h"
+#include "simulation.h"
+
+void EventCalendar::schedule(long long delayMs, Action action) {
+    events.push(Event{currentTime + delayMs, nextSeq++, std::move(action)});
+}
+
+void EventCalendar::runUntil(long long endMs) {
+    while (!events.empty() && events.top().time <= endMs) {
+        Event event = events.top();
+        events.pop();
+        currentTime = event.time;
+        advanceClock();
+        event.action();
+    }
+    currentTime = endMs;
+    advanceClock();
+}
+
+void EventCalendar::advanceClock() {
+    if (clock) clock->advanceTo(std::chrono::milliseconds(currentTime));
+}
+
+EventSimulation::EventSimulation(const ConfigLoader &config, unsigned int seed)
+    : gen(seed), kitchen(buildKitchen(config, clock)) {
+    // Numery dań idą alfabetycznie, więc kolejność nie zależy od mapy i wynik tylko od ziarna
+    auto menu = kitchen->getMenu();
+    for (DishId dish = 0; dish < menu->size(); ++dish) {
+        if (menu->find(dish)) dishIds.push_back(dish);
+    }
+
+    const Catalog &catalog = kitchen->getCatalog();
+    for (const auto &ph: config.getPhilosophers()) {
+        philosopherIndex[ph.id] = philosophers.size();
+        std::vector<LatencyHistogram> mealLatency(catalog.dishes.size());
+        philosophers.push_back(SimPhilosopher{ph.id, ph.name, catalog.dishes.find(ph.favoriteDish), -1, 0, 0.0,
+                                              std::move(mealLatency)});
+    }
+    for (const auto &cookCfg: config.getCooks())
+        cooks.push_back(SimCook{cookCfg.id, static_cast<int>(cooks.size()), catalog.dishes.find(cookCfg.specialtyDish)});
+
+    waiterConfig = config.getWaiterConfig();
+    dishwasherConfig = config.getDishwasher();
+    int waiterCount = config.getWaiterCount();
+    for (int i = 0; i < waiterCount; ++i)
+        waiters.push_back(SimWaiter{kitchen->getServiceQueue().areaFor(i, waiterCount, waiterConfig.helpNeighbours)});
+}
+
+SimulationResult EventSimulation::run(const TimingConfig &timing) {
+    for (auto &p: philosophers)
+        think(p);
+    if (dishwasherConfig.machines > 0) {
+        // Zmywarka ciągła: koniec cyklu to zdarzenie w kalendarzu, po nim kucharze wracają do pracy
+        kitchen->startDishwasher(dishwasherConfig, [this](int delayMs, std::function<void()> action) {
+            calendar.schedule(delayMs, [this, action = std::move(action)]() {
+                action();
+                dispatchCooks();
+            });
+        });
+    } else {
+        scheduleDishwasher(timing.dishwasherIntervalMs, timing.dishwasherDurationMs);
+    }
+    scheduleDelivery(timing.deliveryIntervalMs);
+
+    calendar.runUntil(timing.durationSeconds * 1000LL);
+
+    SimulationResult result;
+    for (const auto &p: philosophers)
+        result.philosophers.push_back(PhilosopherResult{p.name, p.totalExtraWaitTime, p.mealLatency});
+    const Catalog &catalog = kitchen->getCatalog();
+    for (DishId dish = 0; dish < catalog.dishes.size(); ++dish)
+        result.dishNames.push_back(catalog.dishes.name(dish));
+    result.stageLatency = stageLatency;
+    result.income = kitchen->getIncome();
+    result.dishesCooked = kitchen->getDishesTaken();
+    result.specialtyDishes = kitchen->getSpecialtyDishesTaken();
+    return result;
+}
+
+int EventSimulation::randomMs(int minMs, int rangeMs) {
+    std::uniform_int_distribution<int> dist(minMs, minMs + rangeMs - 1);
+    return dist(gen);
+}
+
+EventSimulation::SimPhilosopher &EventSimulation::philosopherById(int philosopherId) {
+    return philosophers[philosopherIndex.at(philosopherId)];
+}
+
+// === Filozof: think -> getHungry -> orderFood -> (kelner) -> eat -> pay ===
+
+void EventSimulation::think(SimPhilosopher &p) {
+    long long thinking = randomMs(1000, 3000);
+    calendar.schedule(thinking + 500, [this, &p]() { orderFood(p); }); // + getHungry
+}
+
+void EventSimulation::orderFood(SimPhilosopher &p) {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+
+    DishId chosenDish = p.favoriteDish;
+    if (dis(gen) >= 0.6) {
+        std::vector<DishId> otherDishes;
+        for (DishId dish: dishIds) {
+            if (dish != p.favoriteDish) otherDishes.push_back(dish);
+        }
+        if (!otherDishes.empty()) {
+            std::uniform_int_distribution<> indexDist(0, otherDishes.size() - 1);
+            chosenDish = otherDishes[indexDist(gen)];
+        }
+    }
+
+    p.currentOrder = chosenDish;
+    OrderTimes times;
+    times.mark(OrderStage::Requested, calendar.now());
+    kitchen->getServiceQueue().requestOrder(p.id, times);
+    dispatchWaiters();
+}
+
+void EventSimulation::receiveFood(SimPhilosopher &p, OrderTimes times) {
+    times.mark(OrderStage::Served, calendar.now());
+    stageLatency.record(times);
+
+    long long waitMs = calendar.now() - times.at(OrderStage::Ordered);
+    double extra = waitMs / 1000.0 - p.cookTimeMs / 1000.0;
+    if (extra > 0)
+        p.totalExtraWaitTime += extra;
+    if (p.currentOrder >= 0 && p.currentOrder < static_cast<int>(p.mealLatency.size()))
+        p.mealLatency[p.currentOrder].record(waitMs);
+
+    calendar.schedule(randomMs(1000, 3000), [this, &p, menu = kitchen->getMenu()]() {
+        // Koniec jedzenia: sztućce do zmywania, potem płatność
+        if (const Kitchen::DishInfo *dish = menu->find(p.currentOrder)) {
+            kitchen->returnUsedCutlery(*dish);
+            if (dish->price > 0.0) kitchen->addIncome(dish->price);
+        }
+        calendar.schedule(500, [this, &p]() { think(p); });
+    });
+}
+
+// === Kelnerzy: kolejka zgłoszeń podzielona na strefy, w strefie najpierw zamówienia ===
+
+void EventSimulation::dispatchWaiters() {
+    ServiceQueue &queue = kitchen->getServiceQueue();
+    bool dispatched = true;
+    while (dispatched) {
+        dispatched = false;
+        for (auto &waiter: waiters) {
+            if (waiter.busy) continue;
+            auto request = queue.tryPop(waiter.area);
+            if (!request) continue;
+
+            std::vector<ServiceRequest> trip{*request};
+            for (const auto &more: queue.takeMore(request->type, request->zone, waiterConfig.maxBatch - 1))
+                trip.push_back(more);
+
+            waiter.busy = true;
+            dispatched = true;
+            bool takeOrder = request->type == ServiceRequest::Type::TakeOrder;
+            for (auto &item: trip)
+                item.times.mark(takeOrder ? OrderStage::PickedUp : OrderStage::DeliveryStarted, calendar.now());
+            if (takeOrder)
+                takeOrders(waiter, std::move(trip));
+            else
+                deliverDishes(waiter, std::move(trip));
+        }
+    }
+}
+
+void EventSimulation::takeOrders(SimWaiter &waiter, std::vector<ServiceRequest> trip) {
+    long long walk = randomMs(200, 400);
+    for (size_t i = 0; i < trip.size(); ++i) {
+        bool last = i + 1 == trip.size();
+        calendar.schedule(walk + i * waiterConfig.itemMs,
+                          [this, &waiter, &p = philosopherById(trip[i].philosopherId), times = trip[i].times, last]() mutable {
+            times.mark(OrderStage::Ordered, calendar.now());
+            kitchen->addOrder(p.id, p.currentOrder, times);
+            p.cookTimeMs = kitchen->getCookingTime(p.currentOrder);
+            dispatchCooks();
+            if (!last) return;
+
+            calendar.schedule(randomMs(200, 400), [this, &waiter]() {
+                waiter.busy = false;
+                dispatchWaiters();
+            });
+        });
+    }
+}
+
+void EventSimulation::deliverDishes(SimWaiter &waiter, std::vector<ServiceRequest> trip) {
+    long long delivery = randomMs(200, 400) + randomMs(300, 500);
+    for (size_t i = 0; i < trip.size(); ++i) {
+        bool last = i + 1 == trip.size();
+        calendar.schedule(delivery + i * waiterConfig.itemMs,
+                          [this, &waiter, philosopherId = trip[i].philosopherId, times = trip[i].times, last]() {
+            if (philosopherIndex.count(philosopherId))
+                receiveFood(philosopherById(philosopherId), times);
+            if (!last) return;
+
+            waiter.busy = false;
+            dispatchWaiters();
+        });
+    }
+}
+
+// === Kucharze ===
+
+void EventSimulation::dispatchCooks() {
+    // Najpierw każdy wolny kucharz bierze ze swojej kolejki, dopiero potem wolni kradną resztę
+    for (auto &cook: cooks) {
+        if (!cook.busy) tryCook(cook, false);
+    }
+    for (auto &cook: cooks) {
+        if (!cook.busy) tryCook(cook);
+    }
+}
+
+void EventSimulation::tryCook(SimCook &cook, bool steal) {
+    // Niewykonalne zamówienia parkują w kuchni; kucharz wraca do pracy dopiero przy
+    // nowym zamówieniu albo po uzupełnieniu zasobów przez zmywarkę lub dostawę
+    auto batch = kitchen->takeCookableBatch(cook.queue, steal);
+    if (!batch) return;
+
+    DishId dish = batch->front().dishId;
+    int baseTime = kitchen->getCookingTime(dish, static_cast<int>(batch->size()));
+    int cookingTime = (dish == cook.specialtyDish) ? static_cast<int>(baseTime * 0.6) : baseTime;
+
+    for (auto &order: *batch)
+        order.times.mark(OrderStage::CookStarted, calendar.now());
+
+    cook.busy = true;
+    calendar.schedule(cookingTime, [this, &cook, batch = std::move(*batch)]() mutable {
+        for (auto &order: batch) {
+            order.times.mark(OrderStage::Ready, calendar.now());
+            kitchen->markDishReady(order);
+        }
+        cook.busy = false;
+        dispatchWaiters();
+        tryCook(cook);
+    });
+}
+
+// === Zmywarka i dostawy ===
+
+void EventSimulation::scheduleDishwasher(int intervalMs, int durationMs) {
+    calendar.schedule(intervalMs, [this, intervalMs, durationMs]() {
+        kitchen->washDirtyCutlery();
+        dispatchCooks();
+        calendar.schedule(durationMs, [this, intervalMs, durationMs]() {
+            scheduleDishwasher(intervalMs, durationMs);
+        });
+    });
+}
+
+void EventSimulation::scheduleDelivery(int intervalMs) {
+    calendar.schedule(intervalMs, [this, intervalMs]() {
+        kitchen->deliverIngredients();
+        dispatchCooks();
+        scheduleDelivery(intervalMs);
+    });
+}
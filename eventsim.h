@@ -0,0 +1,128 @@
+#ifndef EVENTSIM_H
+#define EVENTSIM_H
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ConfigLoader.h"
+#include "clock.h"
+#include "kitchen.h"
+#include "results.h"
+
+// Kalendarz zdarzeń z wirtualnym zegarem (czas w milisekundach).
+// Zdarzenia o tym samym czasie wykonywane są w kolejności dodania.
+class EventCalendar {
+public:
+    using Action = std::function<void()>;
+
+    // Podany zegar ręczny idzie za kalendarzem, żeby kod czytający Clock widział czas symulacji
+    explicit EventCalendar(ManualClock *clock = nullptr) : clock(clock) {}
+
+    long long now() const { return currentTime; }
+
+    void schedule(long long delayMs, Action action);
+
+    // Wykonuje zdarzenia aż do endMs włącznie, potem przesuwa zegar na endMs
+    void runUntil(long long endMs);
+
+private:
+    struct Event {
+        long long time;
+        unsigned long long seq;
+        Action action;
+    };
+
+    struct Later {
+        bool operator()(const Event &a, const Event &b) const {
+            return a.time != b.time ? a.time > b.time : a.seq > b.seq;
+        }
+    };
+
+    void advanceClock();
+
+    std::priority_queue<Event, std::vector<Event>, Later> events;
+    ManualClock *clock;
+    long long currentTime = 0;
+    unsigned long long nextSeq = 0;
+};
+
+// Symulacja zdarzeniowa restauracji: ta sama logika co wersja wątkowa
+// (filozofowie, kelnerzy, kucharze, zmywarka, dostawy), ale bez sleep_for.
+class EventSimulation {
+public:
+    EventSimulation(const ConfigLoader &config, unsigned int seed);
+
+    SimulationResult run(const TimingConfig &timing);
+
+private:
+    struct SimPhilosopher {
+        int id;
+        std::string name;
+        DishId favoriteDish;
+        DishId currentOrder = -1;
+        int cookTimeMs = 0;
+        double totalExtraWaitTime = 0.0;
+        std::vector<LatencyHistogram> mealLatency; // indeks = DishId
+    };
+
+    struct SimWaiter {
+        ServiceArea area;
+        bool busy = false;
+    };
+
+    struct SimCook {
+        int id;
+        int queue; // numer kolejki w kuchni
+        DishId specialtyDish;
+        bool busy = false;
+    };
+
+    int randomMs(int minMs, int rangeMs);
+
+    SimPhilosopher &philosopherById(int philosopherId);
+
+    void think(SimPhilosopher &p);
+
+    void orderFood(SimPhilosopher &p);
+
+    void receiveFood(SimPhilosopher &p, OrderTimes times);
+
+    void dispatchWaiters();
+
+    // Kurs kelnera: droga liczona raz, itemMs za każde zgłoszenie ponad pierwsze
+    void takeOrders(SimWaiter &waiter, std::vector<ServiceRequest> trip);
+
+    void deliverDishes(SimWaiter &waiter, std::vector<ServiceRequest> trip);
+
+    void dispatchCooks();
+
+    // steal == false: tylko własna kolejka kucharza
+    void tryCook(SimCook &cook, bool steal = true);
+
+    void scheduleDishwasher(int intervalMs, int durationMs);
+
+    void scheduleDelivery(int intervalMs);
+
+    // Zegar kuchni (znaczniki zapisu przebiegu) przesuwany przez kalendarz
+    std::shared_ptr<ManualClock> clock = std::make_shared<ManualClock>();
+    EventCalendar calendar{clock.get()};
+    std::mt19937 gen;
+
+    std::shared_ptr<Kitchen> kitchen;
+    std::vector<SimPhilosopher> philosophers;
+    std::unordered_map<int, size_t> philosopherIndex;
+    std::vector<SimCook> cooks;
+    std::vector<DishId> dishIds;
+
+    std::vector<SimWaiter> waiters;
+    WaiterConfig waiterConfig;
+    DishwasherConfig dishwasherConfig;
+    StageLatency stageLatency;
+};
+
+#endif // EVENTSIM_H
@@ -1,160 +1,519 @@
+#include <algorithm>
 #include <iostream>
 #include <thread>
 
 #include "Kitchen.h"
 
-Kitchen::Kitchen() {
+Kitchen::Kitchen(std::shared_ptr<const Catalog> catalog, std::shared_ptr<Clock> clock, size_t queueCapacity)
+    : catalog(std::move(catalog)), inboxCapacity(std::min<size_t>(queueCapacity, 256)),
+      serviceQueue(queueCapacity), clock(std::move(clock)) {
+    auto emptyMenu = std::make_shared<Menu>();
+    emptyMenu->dishes.resize(this->catalog->dishes.size());
+    menu.store(std::move(emptyMenu));
+    specialists.resize(this->catalog->dishes.size());
+    pantry = ResourceStore(this->catalog->ingredients.size());
+    deliveryPlanner = std::make_unique<HeuristicPlanner>(this->catalog->ingredients.size());
+    parkedOnIngredient.resize(this->catalog->ingredients.size());
+    cutlery = ResourceStore(this->catalog->cutlery.size());
+    dirtyCutlery = ResourceStore(this->catalog->cutlery.size());
+    parkedOnCutlery.resize(this->catalog->cutlery.size());
 }
 
-void Kitchen::addIngredient(const std::string &name, int amount) {
-    std::lock_guard<std::mutex> lock(pantryMutex);
-    pantry[name] += amount;
+const Catalog &Kitchen::getCatalog() const {
+    return *catalog;
 }
 
-void Kitchen::addCutlery(const std::string &type, int amount) {
-    std::lock_guard<std::mutex> lock(cutleryMutex);
-    cutlery[type] += amount;
+void Kitchen::addIngredient(IngredientId ingredient, int amount) {
+    if (ingredient < 0 || ingredient >= pantry.size()) {
+        std::cerr << "[KITCHEN] Unknown ingredient id " << ingredient << "\n";
+        return;
+    }
+    pantry.add(ingredient, amount);
+    if (amount > 0) wakeOrdersForIngredients({ingredient});
 }
 
-void Kitchen::addDish(const std::string &dishName, const DishInfo &info) {
-    std::lock_guard<std::mutex> lock(menuMutex);
-    menu[dishName] = info;
+void Kitchen::addCutlery(CutleryId type, int amount) {
+    if (type < 0 || type >= cutlery.size()) {
+        std::cerr << "[KITCHEN] Unknown cutlery id " << type << "\n";
+        return;
+    }
+    cutlery.add(type, amount);
+    if (amount > 0) wakeOrdersForCutlery({type});
 }
 
-void Kitchen::addOrder(int philosopherId, const std::string &dishName) {
-    std::lock_guard<std::mutex> lock(orderQueueMutex);
-    orderQueue.emplace(Order{philosopherId, dishName});
+// Scala powtórzenia i sortuje po numerze; false przy nieznanym numerze lub złej ilości
+static bool normalizeRecipe(std::vector<Kitchen::ResourceAmount> &part, int resourceCount) {
+    std::sort(part.begin(), part.end(), [](const auto &a, const auto &b) { return a.id < b.id; });
+    std::vector<Kitchen::ResourceAmount> merged;
+    for (const auto &item: part) {
+        if (item.id < 0 || item.id >= resourceCount || item.amount <= 0) return false;
+        if (!merged.empty() && merged.back().id == item.id)
+            merged.back().amount += item.amount;
+        else
+            merged.push_back(item);
+    }
+    part = std::move(merged);
+    return true;
 }
 
-std::optional<Kitchen::Order> Kitchen::getNextOrder() {
-    std::lock_guard<std::mutex> lock(orderQueueMutex);
-    if (orderQueue.empty()) return std::nullopt;
+void Kitchen::addDish(DishId dish, DishInfo info) {
+    if (dish < 0 || dish >= catalog->dishes.size() || info.maxBatch < 1 || info.batchPortionMs < 0 ||
+        !normalizeRecipe(info.ingredients, pantry.size()) || !normalizeRecipe(info.cutlery, cutlery.size())) {
+        std::cerr << "[KITCHEN] Dish id " << dish << " has an invalid recipe, skipped\n";
+        return;
+    }
+    std::lock_guard<ProfiledMutex> lock(menuMutex);
+    auto updated = std::make_shared<Menu>(*menu.load());
+    updated->dishes[dish] = std::move(info);
+    menu.store(std::move(updated));
+}
 
-    auto next = orderQueue.front();
-    orderQueue.pop();
-    return next;
+int Kitchen::registerCook(DishId specialtyDish) {
+    int cook = static_cast<int>(cookQueues.size());
+    cookQueues.push_back(std::make_unique<CookQueue>(specialtyDish, inboxCapacity));
+    allCooks.push_back(cook);
+    if (specialtyDish >= 0 && specialtyDish < static_cast<int>(specialists.size()))
+        specialists[specialtyDish].push_back(cook);
+    return cook;
 }
 
-void Kitchen::markDishReady(int philosopherId, const std::string &dishName) {
-    std::lock_guard<std::mutex> lock(readyQueueMutex);
-    readyDishes.emplace(philosopherId, dishName);
+int Kitchen::routeOrder(DishId dish) const {
+    auto shortest = [this](const auto &candidates) {
+        int best = -1, bestPending = 0;
+        for (int cook: candidates) {
+            int pending = cookQueues[cook]->pending.load(std::memory_order_relaxed);
+            if (best < 0 || pending < bestPending) {
+                best = cook;
+                bestPending = pending;
+            }
+        }
+        return best;
+    };
+
+    if (dish >= 0 && dish < static_cast<int>(specialists.size()) && !specialists[dish].empty())
+        return shortest(specialists[dish]);
+    return shortest(allCooks);
 }
 
-bool Kitchen::hasReadyDish() {
-    std::lock_guard<std::mutex> lock(readyQueueMutex);
-    return !readyDishes.empty();
+void Kitchen::pushOrder(CookQueue &queue, QueuedOrder queued) {
+    queue.pending.fetch_add(1, std::memory_order_relaxed);
+    if (queue.inbox.tryPush(std::move(queued))) return;
+
+    // Pełny inbox: zamówienie idzie prosto do kolejki, za tym, co już czekało w inbox
+    std::lock_guard<ProfiledMutex> lock(queue.mutex);
+    while (auto incoming = queue.inbox.tryPop())
+        queue.orders.push_back(std::move(*incoming));
+    queue.orders.push_back(std::move(queued));
 }
 
-std::pair<int, std::string> Kitchen::getReadyDish() {
-    std::lock_guard<std::mutex> lock(readyQueueMutex);
-    auto dish = readyDishes.front();
-    readyDishes.pop();
-    return dish;
+std::optional<Kitchen::QueuedOrder> Kitchen::popOrder(CookQueue &queue, bool fromBack) {
+    if (queue.pending.load(std::memory_order_relaxed) == 0) return std::nullopt;
+
+    std::lock_guard<ProfiledMutex> lock(queue.mutex);
+    while (auto incoming = queue.inbox.tryPop())
+        queue.orders.push_back(std::move(*incoming));
+    if (queue.orders.empty()) return std::nullopt;
+
+    QueuedOrder queued;
+    if (fromBack) {
+        queued = queue.orders.back();
+        queue.orders.pop_back();
+    } else {
+        queued = queue.orders.front();
+        queue.orders.pop_front();
+    }
+    queue.pending.fetch_sub(1, std::memory_order_relaxed);
+    return queued;
+}
+
+std::optional<Kitchen::QueuedOrder> Kitchen::stealOrder(int thief, CookQueue *&victimQueue) {
+    // Ofiara mogła w międzyczasie opróżnić kolejkę, więc próbujemy kolejnych najdłuższych
+    for (size_t attempt = 0; attempt < cookQueues.size(); ++attempt) {
+        int victim = -1, mostPending = 0;
+        for (int cook = 0; cook < static_cast<int>(cookQueues.size()); ++cook) {
+            int pending = cookQueues[cook]->pending.load(std::memory_order_relaxed);
+            if (cook != thief && pending > mostPending) {
+                victim = cook;
+                mostPending = pending;
+            }
+        }
+        if (victim < 0) return std::nullopt;
+        victimQueue = cookQueues[victim].get();
+        if (auto stolen = popOrder(*victimQueue, true)) return stolen;
+    }
+    return std::nullopt;
 }
 
-int Kitchen::getCookingTime(const std::string &dishName) {
-    std::lock_guard<std::mutex> lock(menuMutex);
-    if (!menu.count(dishName)) return 2000; // default 2s
-    return menu.at(dishName).cookTimeMs;
+std::vector<Kitchen::QueuedOrder> Kitchen::takeSameDish(CookQueue &queue, DishId dish, int max) {
+    std::vector<QueuedOrder> taken;
+    if (max <= 0 || queue.pending.load(std::memory_order_relaxed) == 0) return taken;
+
+    std::lock_guard<ProfiledMutex> lock(queue.mutex);
+    while (auto incoming = queue.inbox.tryPop())
+        queue.orders.push_back(std::move(*incoming));
+    for (auto it = queue.orders.begin(); it != queue.orders.end() && static_cast<int>(taken.size()) < max;) {
+        if (it->order.dishId == dish) {
+            taken.push_back(*it);
+            it = queue.orders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    queue.pending.fetch_sub(static_cast<int>(taken.size()), std::memory_order_relaxed);
+    return taken;
 }
 
-const std::unordered_map<std::string, Kitchen::DishInfo> &Kitchen::getMenu() const {
-    return menu;
+void Kitchen::addOrder(int philosopherId, DishId dish, const OrderTimes &times) {
+    QueuedOrder queued{nextOrderSeq.fetch_add(1, std::memory_order_relaxed), Order{philosopherId, dish, times}};
+    int cook = routeOrder(dish);
+    pushOrder(cook >= 0 ? *cookQueues[cook] : unassigned, std::move(queued));
+    notifyCooks(cook);
+
+    auto currentMenu = menu.load();
+    if (const DishInfo *info = currentMenu->find(dish)) {
+        for (const auto &need: info->ingredients)
+            deliveryPlanner->recordDemand(need.id, need.amount);
+    }
 }
 
-const std::unordered_map<std::string, int> &Kitchen::getPantry() const {
-    return pantry;
+void Kitchen::notifyCooks(int preferredCook) {
+    cooks.notify(preferredCook);
 }
 
-const std::unordered_map<std::string, int> &Kitchen::getCutleryStock() const {
-    return cutlery;
+void Kitchen::closeOrders() {
+    cooks.close();
 }
 
-bool Kitchen::canPrepare(const std::string &dishName) {
-    std::lock_guard<std::mutex> lock1(pantryMutex);
-    std::lock_guard<std::mutex> lock2(cutleryMutex);
-    std::lock_guard<std::mutex> lock3(menuMutex);
+std::optional<Kitchen::Batch> Kitchen::takeCookableBatch(int cook, bool steal) {
+    if (cook < 0 || cook >= static_cast<int>(cookQueues.size())) {
+        std::cerr << "[KITCHEN] Unknown cook queue " << cook << "\n";
+        return std::nullopt;
+    }
+    CookQueue &own = *cookQueues[cook];
+    auto currentMenu = menu.load();
 
-    if (!menu.count(dishName)) return false;
+    for (;;) {
+        CookQueue *source = &own;
+        auto next = popOrder(own, false);
+        if (!next) {
+            source = &unassigned;
+            next = popOrder(unassigned, false);
+        }
+        if (!next && steal) next = stealOrder(cook, source);
+        if (!next) return std::nullopt;
 
-    const auto &dish = menu.at(dishName);
-    return pantry[dish.ingredient] > 0 && cutlery[dish.cutlery] > 0;
+        DishId dishId = next->order.dishId;
+        const DishInfo *dish = currentMenu->find(dishId);
+        if (!dish) {
+            std::cerr << "[KITCHEN] Unknown dish id " << dishId << ", order dropped\n";
+            continue;
+        }
+        if (!reserveOrPark(*next, *dish)) continue;
+
+        // Partia: kolejne zamówienia na to samo danie z kolejki, z której wzięliśmy pierwsze
+        Batch batch{next->order};
+        for (const auto &extra: takeSameDish(*source, dishId, dish->maxBatch - 1)) {
+            if (reserveOrPark(extra, *dish)) batch.push_back(extra.order);
+        }
+
+        int portions = static_cast<int>(batch.size());
+        dishesTaken.fetch_add(portions, std::memory_order_relaxed);
+        if (dishId == own.specialtyDish)
+            specialtyDishesTaken.fetch_add(portions, std::memory_order_relaxed);
+        return batch;
+    }
 }
 
-bool Kitchen::reserveResourcesFor(const std::string &dishName) {
-    std::lock_guard<std::mutex> lock1(pantryMutex);
-    std::lock_guard<std::mutex> lock2(cutleryMutex);
-    std::lock_guard<std::mutex> lock3(menuMutex);
+bool Kitchen::reserveOrPark(const QueuedOrder &queued, const DishInfo &dish) {
+    // Zasoby rezerwujemy bez blokad; parkedMutex chroni tylko indeks zaparkowanych
+    Shortage shortage;
+    do {
+        shortage = tryReserve(dish);
+    } while (shortage.kind != Shortage::Kind::None && !parkOrder(queued, dish, shortage));
+
+    if (tracer && shortage.kind != Shortage::Kind::None) {
+        bool ingredient = shortage.kind == Shortage::Kind::Ingredient;
+        const NameTable &names = ingredient ? catalog->ingredients : catalog->cutlery;
+        tracer->instant(Tracer::kitchenTrack, "Reserve failure", clock->now().count(),
+                        ingredient ? "ingredient" : "cutlery", names.name(shortage.id).c_str());
+    }
+
+    // Zamówienie czeka na sztućce: zmywarka ciągła rusza z tym, co już jest brudne
+    if (shortage.kind == Shortage::Kind::Cutlery && dishwasher) dishwasher->poke();
+    return shortage.kind == Shortage::Kind::None;
+}
 
-    if (!menu.count(dishName)) return false;
+bool Kitchen::parkOrder(const QueuedOrder &queued, const DishInfo &dish, const Shortage &shortage) {
+    std::lock_guard<ProfiledMutex> lock(parkedMutex);
 
-    auto &dish = menu.at(dishName);
-    if (pantry[dish.ingredient] <= 0 || cutlery[dish.cutlery] <= 0) return false;
+    // Zasoby wzięte przed brakiem oddaliśmy bez budzenia; zamówienie, które w tym czasie
+    // zobaczyło przez nas zero i zaparkowało, wraca do kolejki
+    wakeRolledBack(dish, shortage);
 
-    pantry[dish.ingredient]--;
-    cutlery[dish.cutlery]--;
+    // Uzupełnienie najpierw zwiększa licznik, potem bierze parkedMutex, żeby obudzić zamówienia:
+    // albo tu widzimy nowy zapas, albo uzupełniający zobaczy nasze zamówienie
+    bool ingredient = shortage.kind == Shortage::Kind::Ingredient;
+    ResourceStore &store = ingredient ? pantry : cutlery;
+    if (store.get(shortage.id) >= shortage.amount) return false;
+    (ingredient ? parkedOnIngredient : parkedOnCutlery)[shortage.id].push_back(queued);
     return true;
 }
 
+void Kitchen::wakeParkedOrders(ParkedOrders &parked, int resource) {
+    auto &orders = parked[resource];
+    // Od najnowszego, żeby po wstawieniu na początek najstarsze było pierwsze
+    std::sort(orders.begin(), orders.end(), [](const auto &a, const auto &b) { return a.seq > b.seq; });
+    for (const auto &queued: orders) {
+        int cook = routeOrder(queued.order.dishId);
+        CookQueue &queue = cook >= 0 ? *cookQueues[cook] : unassigned;
+        std::lock_guard<ProfiledMutex> lock(queue.mutex);
+        queue.orders.push_front(queued);
+        queue.pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    orders.clear();
+}
+
+void Kitchen::wakeRolledBack(const DishInfo &dish, const Shortage &shortage) {
+    for (const auto &need: dish.ingredients) {
+        if (shortage.kind == Shortage::Kind::Ingredient && need.id == shortage.id) break;
+        wakeParkedOrders(parkedOnIngredient, need.id);
+    }
+    if (shortage.kind == Shortage::Kind::Cutlery) {
+        for (const auto &need: dish.cutlery) {
+            if (need.id == shortage.id) break;
+            wakeParkedOrders(parkedOnCutlery, need.id);
+        }
+    }
+}
+
+void Kitchen::wakeOrdersForIngredients(const std::vector<IngredientId> &ingredients) {
+    {
+        std::lock_guard<ProfiledMutex> lock(parkedMutex);
+        for (IngredientId ingredient: ingredients)
+            wakeParkedOrders(parkedOnIngredient, ingredient);
+    }
+    notifyCooks();
+}
+
+void Kitchen::wakeOrdersForCutlery(const std::vector<CutleryId> &types) {
+    {
+        std::lock_guard<ProfiledMutex> lock(parkedMutex);
+        for (CutleryId type: types)
+            wakeParkedOrders(parkedOnCutlery, type);
+    }
+    notifyCooks();
+}
+
+void Kitchen::markDishReady(const Order &order) {
+    serviceQueue.dishReady(order.philosopherId, order.dishId, order.times);
+}
+
+ServiceQueue &Kitchen::getServiceQueue() {
+    return serviceQueue;
+}
+
+int Kitchen::getCookingTime(DishId dish, int portions) {
+    auto currentMenu = menu.load();
+    const DishInfo *info = currentMenu->find(dish);
+    if (!info) return 2000; // default 2s
+    return info->cookTimeMs + std::max(0, portions - 1) * info->batchPortionMs;
+}
+
+std::shared_ptr<const Kitchen::Menu> Kitchen::getMenu() const {
+    return menu.load();
+}
+
+// Bierze pozycje po kolei; zwraca liczbę wziętych (== size() przy sukcesie)
+static size_t takeInOrder(ResourceStore &store, const std::vector<Kitchen::ResourceAmount> &part) {
+    size_t taken = 0;
+    while (taken < part.size() && store.tryTake(part[taken].id, part[taken].amount))
+        ++taken;
+    return taken;
+}
+
+static void giveBack(ResourceStore &store, const std::vector<Kitchen::ResourceAmount> &part, size_t taken) {
+    while (taken > 0) {
+        --taken;
+        store.add(part[taken].id, part[taken].amount);
+    }
+}
+
+Kitchen::Shortage Kitchen::tryReserve(const DishInfo &dish) {
+    size_t ingredientsTaken = takeInOrder(pantry, dish.ingredients);
+    if (ingredientsTaken < dish.ingredients.size()) {
+        giveBack(pantry, dish.ingredients, ingredientsTaken);
+        const auto &missing = dish.ingredients[ingredientsTaken];
+        return Shortage{Shortage::Kind::Ingredient, missing.id, missing.amount};
+    }
+
+    size_t cutleryTaken = takeInOrder(cutlery, dish.cutlery);
+    if (cutleryTaken < dish.cutlery.size()) {
+        giveBack(cutlery, dish.cutlery, cutleryTaken);
+        giveBack(pantry, dish.ingredients, ingredientsTaken);
+        const auto &missing = dish.cutlery[cutleryTaken];
+        return Shortage{Shortage::Kind::Cutlery, missing.id, missing.amount};
+    }
+    return Shortage{};
+}
+
+std::vector<int> Kitchen::getPantry() const {
+    return pantry.snapshot();
+}
+
+std::vector<int> Kitchen::getCutleryStock() const {
+    return cutlery.snapshot();
+}
+
+bool Kitchen::canPrepare(DishId dish) {
+    auto currentMenu = menu.load();
+    const DishInfo *info = currentMenu->find(dish);
+    if (!info) return false;
+    for (const auto &need: info->ingredients) {
+        if (pantry.get(need.id) < need.amount) return false;
+    }
+    for (const auto &need: info->cutlery) {
+        if (cutlery.get(need.id) < need.amount) return false;
+    }
+    return true;
+}
+
+bool Kitchen::reserveResourcesFor(DishId dish) {
+    auto currentMenu = menu.load();
+    const DishInfo *info = currentMenu->find(dish);
+    if (!info) return false;
+
+    Shortage shortage = tryReserve(*info);
+    if (shortage.kind == Shortage::Kind::None) return true;
+
+    // Wycofane zasoby mogły na chwilę zasłonić zapas zamówieniom, które przez to zaparkowały
+    {
+        std::lock_guard<ProfiledMutex> lock(parkedMutex);
+        wakeRolledBack(*info, shortage);
+    }
+    notifyCooks();
+    return false;
+}
+
+int Kitchen::getDishesTaken() const {
+    return dishesTaken.load(std::memory_order_relaxed);
+}
+
+int Kitchen::getSpecialtyDishesTaken() const {
+    return specialtyDishesTaken.load(std::memory_order_relaxed);
+}
+
 void Kitchen::addIncome(double amount) {
-    std::lock_guard<std::mutex> lock(incomeMutex);
+    std::lock_guard<ProfiledMutex> lock(incomeMutex);
     income += amount;
 }
 
 double Kitchen::getIncome() {
-    std::lock_guard<std::mutex> lock(incomeMutex);
+    std::lock_guard<ProfiledMutex> lock(incomeMutex);
     return income;
 }
 
-void Kitchen::returnUsedCutlery(const std::string &type) {
-    std::lock_guard<std::mutex> lock(dirtyMutex);
-    dirtyCutlery[type]++;
+void Kitchen::returnUsedCutlery(CutleryId type, int amount) {
+    if (type < 0 || type >= dirtyCutlery.size()) return;
+    dirtyCutlery.add(type, amount);
+    if (dishwasher) dishwasher->poke();
+}
+
+void Kitchen::returnUsedCutlery(const DishInfo &dish) {
+    for (const auto &used: dish.cutlery)
+        returnUsedCutlery(used.id, used.amount);
+}
+
+void Kitchen::washDirtyCutlery() {
+    std::vector<CutleryId> washed;
+    for (CutleryId type = 0; type < dirtyCutlery.size(); ++type) {
+        int clean = dirtyCutlery.takeAll(type);
+        if (clean == 0) continue;
+        cutlery.add(type, clean);
+        washed.push_back(type);
+    }
+    if (tracer) tracer->instant(Tracer::kitchenTrack, "Dishwasher cycle", clock->now().count());
+    wakeOrdersForCutlery(washed);
+}
+
+void Kitchen::setTracer(Tracer *tracer) {
+    this->tracer = tracer;
+}
+
+void Kitchen::setDeliveryPlanner(std::unique_ptr<DeliveryPlanner> planner) {
+    std::lock_guard<ProfiledMutex> deliveryLock(deliveryMutex);
+    deliveryPlanner = std::move(planner);
+}
+
+void Kitchen::deliverIngredients() {
+    std::vector<IngredientId> delivered;
+    {
+        std::lock_guard<ProfiledMutex> deliveryLock(deliveryMutex);
+
+        std::vector<int> amounts = deliveryPlanner->deliver(pantry.snapshot());
+        for (IngredientId ingredient = 0; ingredient < pantry.size(); ++ingredient) {
+            if (amounts[ingredient] <= 0) continue;
+            pantry.add(ingredient, amounts[ingredient]);
+            delivered.push_back(ingredient);
+        }
+    }
+    if (tracer) tracer->instant(Tracer::kitchenTrack, "Delivery", clock->now().count());
+    wakeOrdersForIngredients(delivered);
 }
 
 void Kitchen::runDishwasher(int intervalMs, int durationMs) {
-    dishwasherThread = std::thread([=]() {
+    dishwasherThread = std::thread([this, intervalMs, durationMs]() {
         while (running) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
-            if (!running) break; {
-                std::lock_guard<std::mutex> dirtyLock(dirtyMutex);
-                std::lock_guard<std::mutex> cleanLock(cutleryMutex);
-                for (auto &pair: dirtyCutlery) {
-                    cutlery[pair.first] += pair.second;
-                }
-                dirtyCutlery.clear();
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+            clock->sleepForMs(intervalMs);
+            if (!running) break;
+            washDirtyCutlery();
+            clock->sleepForMs(durationMs);
         }
     });
 }
 
+void Kitchen::startDishwasher(const DishwasherConfig &config, Dishwasher::Timer timer) {
+    long long cycleUs = config.cycleMs * 1000LL;
+    auto onWashed = [this, cycleUs](const std::vector<CutleryId> &types) {
+        if (tracer) tracer->complete(Tracer::kitchenTrack, "Dishwasher cycle", clock->now().count() - cycleUs, cycleUs);
+        wakeOrdersForCutlery(types);
+    };
+    dishwasher = std::make_unique<Dishwasher>(config, dirtyCutlery, cutlery, std::move(timer), std::move(onWashed));
+}
+
 void Kitchen::startIngredientDelivery(int intervalMs) {
     deliveryThread = std::thread([this, intervalMs]() {
         while (running) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            clock->sleepForMs(intervalMs);
             if (!running) break;
 
-            std::lock_guard<std::mutex> lock(pantryMutex);
-            std::lock_guard<std::mutex> deliveryLock(deliveryMutex);
-
             std::cout << "[DELIVERY] Food delivery has arrived\n";
-
-            for (auto &[ingredient, amount]: pantry) {
-                int &plannedAmount = deliveryPlan[ingredient];
-                if (plannedAmount == 0) plannedAmount = 5;
-                if (amount == 0) {
-                    plannedAmount += 2;
-                } else if (amount > plannedAmount) {
-                    plannedAmount = std::max(1, plannedAmount - 1);
-                }
-                pantry[ingredient] += plannedAmount;
-            }
+            deliverIngredients();
         }
     });
 }
 
+void Kitchen::runDishwasher(TaskScheduler &scheduler, int intervalMs, int durationMs) {
+    scheduler.postAfterMs(intervalMs, [this, &scheduler, intervalMs, durationMs]() {
+        if (!running) return;
+        washDirtyCutlery();
+        scheduler.postAfterMs(durationMs, [this, &scheduler, intervalMs, durationMs]() {
+            runDishwasher(scheduler, intervalMs, durationMs);
+        });
+    });
+}
+
+void Kitchen::startIngredientDelivery(TaskScheduler &scheduler, int intervalMs) {
+    scheduler.postAfterMs(intervalMs, [this, &scheduler, intervalMs]() {
+        if (!running) return;
+        std::cout << "[DELIVERY] Food delivery has arrived\n";
+        deliverIngredients();
+        startIngredientDelivery(scheduler, intervalMs);
+    });
+}
+
 void Kitchen::stopBackgroundTasks() {
     running = false;
+    if (dishwasher) dishwasher->stop();
     if (dishwasherThread.joinable()) dishwasherThread.join();
     if (deliveryThread.joinable()) deliveryThread.join();
 }
@@ -2,85 +2,268 @@
 #define KITCHEN_H
 
 #include <string>
-#include <unordered_map>
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <optional>
 #include <atomic>
 #include <thread>
+#include <memory>
+#include <vector>
+#include "catalog.h"
+#include "clock.h"
+#include "deliveryplanner.h"
+#include "dishwasher.h"
+#include "scheduler.h"
+#include "mpmcqueue.h"
+#include "ordertrace.h"
+#include "parkinglot.h"
+#include "profiledmutex.h"
+#include "resourcestore.h"
+#include "servicequeue.h"
+#include "tracer.h"
 
 class Kitchen {
 public:
+    struct ResourceAmount {
+        int id;
+        int amount;
+    };
+
+    // Przepis: składniki i sztućce z ilościami na porcję, posortowane rosnąco po numerze
     struct DishInfo {
-        std::string ingredient;
-        std::string cutlery;
+        std::vector<ResourceAmount> ingredients;
+        std::vector<ResourceAmount> cutlery;
         int cookTimeMs;
         double price;
+        int maxBatch = 1; // ile porcji kucharz może gotować naraz
+        int batchPortionMs = 0; // dodatkowy czas za każdą porcję ponad pierwszą
     };
 
     struct Order {
         int philosopherId;
-        std::string dishName;
+        DishId dishId;
+        OrderTimes times; // znaczniki etapów stawiają agenci, kuchnia je tylko przenosi
+    };
+
+    // Zamówienia na to samo danie gotowane razem; zasoby każdej porcji są już zarezerwowane
+    using Batch = std::vector<Order>;
+
+    // Niezmienna migawka menu. Czytelnicy trzymają shared_ptr bez blokad i kopiowania;
+    // addDish buduje nową migawkę i podmienia ją atomowo.
+    class Menu {
+    public:
+        // nullptr, gdy dania nie ma w menu
+        const DishInfo *find(DishId dish) const {
+            if (dish < 0 || dish >= size() || !dishes[dish]) return nullptr;
+            return &*dishes[dish];
+        }
+
+        int size() const { return static_cast<int>(dishes.size()); }
+
+        std::vector<std::optional<DishInfo> > dishes; // indeks = DishId
     };
 
-    Kitchen();
+    // Zasoby w tablicach indeksowanych numerami z katalogu.
+    // queueCapacity: pojemność kolejek bez blokad, wystarczy liczba filozofów
+    explicit Kitchen(std::shared_ptr<const Catalog> catalog,
+                     std::shared_ptr<Clock> clock = std::make_shared<RealClock>(), size_t queueCapacity = 1024);
+
+    const Catalog &getCatalog() const;
+
+    void addIngredient(IngredientId ingredient, int amount);
+
+    void addCutlery(CutleryId type, int amount);
+
+    // Scala powtórzone pozycje przepisu i sortuje je według numeru zasobu
+    void addDish(DishId dish, DishInfo info);
+
+    // Każdy kucharz ma własną kolejkę zamówień. Rejestracja tylko przed startem agentów;
+    // zwraca numer kolejki kucharza.
+    int registerCook(DishId specialtyDish);
 
-    void addIngredient(const std::string &name, int amount);
+    // Zamówienie trafia do kolejki specjalisty od tego dania (najkrótszej, gdy jest ich kilku),
+    // a bez specjalisty do najkrótszej kolejki w ogóle. Składniki przepisu idą jako popyt do planisty dostaw.
+    void addOrder(int philosopherId, DishId dish, const OrderTimes &times = OrderTimes());
 
-    void addCutlery(const std::string &type, int amount);
+    // Zdejmuje najstarsze zamówienie z kolejki kucharza, które da się teraz ugotować, i od razu
+    // rezerwuje jego zasoby. Przy pustej kolejce (i steal == true) kradnie z końca najdłuższej
+    // cudzej kolejki. Zamówienia bez składnika lub sztućców parkują przy brakującym zasobie.
+    // Dla dań z maxBatch > 1 dobiera z tej samej kolejki kolejne zamówienia na to danie.
+    std::optional<Batch> takeCookableBatch(int cook, bool steal = true);
 
-    void addDish(const std::string &dishName, const DishInfo &info);
+    // Blokujący wariant dla kucharzy: parkuje do nowego zamówienia lub uzupełnienia zasobów.
+    // Pusty wynik oznacza zamkniętą kuchnię.
+    ParkingLot<Batch>::Awaiter nextCookableBatch(TaskScheduler *scheduler, int cook) {
+        return cooks.wait(scheduler, [this, cook] { return takeCookableBatch(cook); }, cook);
+    }
 
-    void addOrder(int philosopherId, const std::string &dishName);
+    // Porcje wydane kucharzom i ile z nich trafiło do specjalisty od danego dania
+    int getDishesTaken() const;
 
-    std::optional<Order> getNextOrder();
+    int getSpecialtyDishesTaken() const;
 
-    void markDishReady(int philosopherId, const std::string &dishName);
+    // Budzi zaparkowanych kucharzy z pustym wynikiem
+    void closeOrders();
 
-    bool hasReadyDish();
+    // Gotowe danie trafia jako zgłoszenie do kolejki kelnerów, razem ze znacznikami etapów
+    void markDishReady(const Order &order);
 
-    std::pair<int, std::string> getReadyDish();
+    ServiceQueue &getServiceQueue();
 
-    int getCookingTime(const std::string &dishName);
+    // Czas gotowania partii: cookTimeMs + batchPortionMs za każdą porcję ponad pierwszą
+    int getCookingTime(DishId dish, int portions = 1);
 
-    const std::unordered_map<std::string, DishInfo> &getMenu() const;
+    std::shared_ptr<const Menu> getMenu() const;
 
-    const std::unordered_map<std::string, int> &getPantry() const;
+    // Odczyt liczników do wyświetlania; indeks = IngredientId / CutleryId
+    std::vector<int> getPantry() const;
 
-    const std::unordered_map<std::string, int> &getCutleryStock() const;
+    std::vector<int> getCutleryStock() const;
 
-    bool canPrepare(const std::string &dishName);
+    bool canPrepare(DishId dish);
 
-    bool reserveResourcesFor(const std::string &dishName);
+    bool reserveResourcesFor(DishId dish);
 
     void addIncome(double amount);
 
     double getIncome();
 
-    void returnUsedCutlery(const std::string &type);
+    void returnUsedCutlery(CutleryId type, int amount = 1);
+
+    // Wszystkie sztućce z przepisu wracają do zmywania
+    void returnUsedCutlery(const DishInfo &dish);
+
+    // Pojedynczy cykl zmywarki: brudne sztućce wracają do czystych
+    void washDirtyCutlery();
+
+    // Dostawy, cykle zmywarki i nieudane rezerwacje trafiają do zapisu przebiegu; tylko przed startem agentów
+    void setTracer(Tracer *tracer);
+
+    // Polityka dostaw (domyślnie HeuristicPlanner); tylko przed startem agentów
+    void setDeliveryPlanner(std::unique_ptr<DeliveryPlanner> planner);
+
+    // Pojedyncza dostawa składników: ilości wybiera planista dostaw
+    void deliverIngredients();
 
     void runDishwasher(int intervalMs, int durationMs);
 
+    // Zmywarka ciągła zamiast okresowej (config.machines > 0); timer odmierza cykle maszyn.
+    // Tylko przed startem agentów.
+    void startDishwasher(const DishwasherConfig &config, Dishwasher::Timer timer);
+
     void startIngredientDelivery(int intervalMs);
 
+    // Te same zadania w trybie M:N: cykle jako timery planisty zamiast osobnych wątków
+    void runDishwasher(TaskScheduler &scheduler, int intervalMs, int durationMs);
+
+    void startIngredientDelivery(TaskScheduler &scheduler, int intervalMs);
+
     void stopBackgroundTasks(); // <-- nowa funkcja
 
 private:
-    std::unordered_map<std::string, DishInfo> menu;
-    std::unordered_map<std::string, int> pantry;
-    std::unordered_map<std::string, int> cutlery;
-    std::unordered_map<std::string, int> dirtyCutlery;
-    std::unordered_map<std::string, int> deliveryPlan;
+    std::shared_ptr<const Catalog> catalog;
+
+    std::atomic<std::shared_ptr<const Menu> > menu;
+    ResourceStore pantry;
+    ResourceStore cutlery;
+    ResourceStore dirtyCutlery;
+    std::unique_ptr<DeliveryPlanner> deliveryPlanner; // deliver() tylko pod deliveryMutex
+    std::unique_ptr<Dishwasher> dishwasher; // zmywarka ciągła; bez niej myje runDishwasher
 
-    std::queue<Order> orderQueue;
-    std::queue<std::pair<int, std::string> > readyDishes;
+    struct Shortage {
+        enum class Kind { None, Ingredient, Cutlery };
+
+        Kind kind = Kind::None;
+        int id = -1; // pierwszy brakujący zasób
+        int amount = 0;
+    };
 
-    std::mutex menuMutex, pantryMutex, cutleryMutex, dirtyMutex;
-    std::mutex orderQueueMutex, readyQueueMutex;
-    std::mutex deliveryMutex, incomeMutex;
+    // Rezerwacja całego przepisu bez blokad, wszystko albo nic. Zasoby bierzemy w stałej kolejności
+    // (składniki, potem sztućce, rosnąco po numerze), a przy braku oddajemy już wzięte.
+    // Bez blokad nie ma zakleszczeń, a wspólna kolejność sprawia, że dwóch rezerwujących ten sam
+    // przepis rozstrzyga się na pierwszym zasobie, zamiast wzajemnie wycofywać się w nieskończoność.
+    Shortage tryReserve(const DishInfo &dish);
+
+    // Numer przyjęcia zamówienia: obudzone zamówienie wraca przed nowsze
+    struct QueuedOrder {
+        unsigned long long seq = 0;
+        Order order;
+    };
+
+    // Kolejka jednego kucharza. Kelnerzy odkładają zamówienia do inbox bez blokady; pod mutexem
+    // są przenoszone do orders, skąd właściciel bierze z przodu, a złodzieje z tyłu.
+    struct CookQueue {
+        CookQueue(DishId specialtyDish, size_t inboxCapacity)
+            : specialtyDish(specialtyDish), inbox(inboxCapacity) {
+        }
+
+        DishId specialtyDish;
+        MpmcQueue<QueuedOrder> inbox;
+        ProfiledMutex mutex{"kitchen.cookQueue"};
+        std::deque<QueuedOrder> orders;
+        std::atomic<int> pending{0}; // inbox + orders, do wyboru najkrótszej kolejki
+    };
+
+    // Numer kolejki, do której trafia zamówienie na dane danie
+    int routeOrder(DishId dish) const;
+
+    void pushOrder(CookQueue &queue, QueuedOrder queued);
+
+    std::optional<QueuedOrder> popOrder(CookQueue &queue, bool fromBack);
+
+    // Z kolejki z najwięcej oczekującymi poza kolejką złodzieja; victim = kolejka ofiary
+    std::optional<QueuedOrder> stealOrder(int thief, CookQueue *&victim);
+
+    // Wyjmuje z kolejki do max najstarszych zamówień na dane danie
+    std::vector<QueuedOrder> takeSameDish(CookQueue &queue, DishId dish, int max);
+
+    // Rezerwuje zasoby zamówienia albo je parkuje; true = zarezerwowane
+    bool reserveOrPark(const QueuedOrder &queued, const DishInfo &dish);
+
+    // Indeks = numer brakującego zasobu
+    using ParkedOrders = std::vector<std::vector<QueuedOrder> >;
+
+    // Parkuje zamówienie przy brakującym zasobie; false, jeśli zasób zdążył wrócić i trzeba
+    // spróbować jeszcze raz. Budzi też zamówienia zaparkowane przy zasobach, które dish
+    // na chwilę zabrał i oddał.
+    bool parkOrder(const QueuedOrder &queued, const DishInfo &dish, const Shortage &shortage);
+
+    // Wymaga parkedMutex: przenosi zaparkowane zamówienia z powrotem do kolejek kucharzy
+    void wakeParkedOrders(ParkedOrders &parked, int resource);
+
+    // Wymaga parkedMutex: budzi zamówienia przy zasobach wziętych przed brakiem i oddanych
+    void wakeRolledBack(const DishInfo &dish, const Shortage &shortage);
+
+    void wakeOrdersForIngredients(const std::vector<IngredientId> &ingredients);
+
+    void wakeOrdersForCutlery(const std::vector<CutleryId> &types);
+
+    void notifyCooks(int preferredCook = -1);
+
+    size_t inboxCapacity;
+    std::atomic<unsigned long long> nextOrderSeq = 0;
+    std::vector<std::unique_ptr<CookQueue> > cookQueues; // stałe po starcie agentów
+    std::vector<int> allCooks;
+    std::vector<std::vector<int> > specialists; // indeks = DishId, wartości = numery kolejek
+    CookQueue unassigned{-1, 64}; // zamówienia złożone, gdy nie ma żadnego kucharza
+    ParkedOrders parkedOnIngredient;
+    ParkedOrders parkedOnCutlery;
+    ParkingLot<Batch> cooks{true, "kitchen.cookParking"};
+    ServiceQueue serviceQueue;
+
+    std::atomic<int> dishesTaken = 0;
+    std::atomic<int> specialtyDishesTaken = 0;
+
+    ProfiledMutex menuMutex{"kitchen.menu"}; // tylko dla piszących: kolejne addDish nie gubią swoich zmian
+    ProfiledMutex parkedMutex{"kitchen.parked"}; // indeks zaparkowanych; zawsze przed mutexem kolejki kucharza
+    ProfiledMutex deliveryMutex{"kitchen.delivery"};
+    ProfiledMutex incomeMutex{"kitchen.income"};
 
     double income = 0.0;
 
+    std::shared_ptr<Clock> clock;
+    Tracer *tracer = nullptr;
+
     std::atomic<bool> running = true;
     std::thread dishwasherThread;
     std::thread deliveryThread;
@@ -0,0 +1,57 @@
+#include "latencyhistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+std::size_t LatencyHistogram::bucketIndex(long long value) {
+    if (value < subBucketCount) return static_cast<std::size_t>(value);
+    // value >> shift trafia w [64, 128): shift to numer połówkowej grupy kubełków
+    int shift = std::bit_width(static_cast<unsigned long long>(value)) - subBucketBits;
+    return static_cast<std::size_t>(subBucketCount + (shift - 1) * subBucketHalf + ((value >> shift) - subBucketHalf));
+}
+
+long long LatencyHistogram::bucketHighest(std::size_t index) {
+    long long i = static_cast<long long>(index);
+    if (i < subBucketCount) return i;
+    long long shift = (i - subBucketCount) / subBucketHalf + 1;
+    long long sub = (i - subBucketCount) % subBucketHalf + subBucketHalf;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(long long valueMs) {
+    valueMs = std::max(0LL, valueMs);
+    std::size_t index = bucketIndex(valueMs);
+    if (index >= counts.size()) counts.resize(index + 1, 0);
+    ++counts[index];
+
+    minValue = total == 0 ? valueMs : std::min(minValue, valueMs);
+    maxValue = std::max(maxValue, valueMs);
+    sum += valueMs;
+    ++total;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    if (other.total == 0) return;
+    if (other.counts.size() > counts.size()) counts.resize(other.counts.size(), 0);
+    for (std::size_t i = 0; i < other.counts.size(); ++i)
+        counts[i] += other.counts[i];
+
+    minValue = total == 0 ? other.minValue : std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+    total += other.total;
+}
+
+long long LatencyHistogram::percentile(double percent) const {
+    if (total == 0) return 0;
+    percent = std::clamp(percent, 0.0, 100.0);
+    long long rank = std::max(1LL, static_cast<long long>(std::ceil(percent / 100.0 * total)));
+
+    long long seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::clamp(bucketHighest(i), minValue, maxValue);
+    }
+    return maxValue;
+}
@@ -0,0 +1,46 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <cstddef>
+#include <vector>
+
+// Histogram opóźnień w stylu HDR: kubełki liniowe do 128 ms, dalej w każdej potędze dwójki
+// po 64 kubełki, więc błąd względny percentyla nie przekracza 1/64 (~1.6%) w całym zakresie.
+// Zapis to jedno zwiększenie licznika bez alokacji (poza wzrostem tablicy do nowego maksimum).
+// Jeden piszący naraz; scalanie i odczyt po zakończeniu symulacji.
+class LatencyHistogram {
+public:
+    void record(long long valueMs);
+
+    void merge(const LatencyHistogram &other);
+
+    long long count() const { return total; }
+
+    long long min() const { return total > 0 ? minValue : 0; }
+
+    long long max() const { return maxValue; }
+
+    double mean() const { return total > 0 ? static_cast<double>(sum) / total : 0.0; }
+
+    // Najmniejsza wartość, od której co najwyżej (100 - percent)% próbek jest większych,
+    // z dokładnością do szerokości kubełka; 0 dla pustego histogramu
+    long long percentile(double percent) const;
+
+private:
+    static constexpr int subBucketBits = 7;
+    static constexpr long long subBucketCount = 1LL << subBucketBits; // 128
+    static constexpr long long subBucketHalf = subBucketCount / 2; // 64
+
+    static std::size_t bucketIndex(long long value);
+
+    // Największa wartość trafiająca do kubełka
+    static long long bucketHighest(std::size_t index);
+
+    std::vector<long long> counts;
+    long long total = 0;
+    long long sum = 0;
+    long long minValue = 0;
+    long long maxValue = 0;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -1,29 +1,30 @@
 #include "ConfigLoader.h"
-#include "Philosopher.h"
-#include "Waiter.h"
-#include "Cook.h"
-#include "Kitchen.h"
-#include "display.h"
+#include "profiledmutex.h"
+#include "replication.h"
+#include "results.h"
+#include "simulation.h"
+#include "sweep.h"
 
 #include <iostream>
 #include <fstream>
-#include <thread>
 #include <vector>
-#include <memory>
-#include <unordered_map>
-#include <mutex>
 #include <string>
-#include <iomanip>
 
-int main() {
-    std::vector<std::string> configFiles = {
-        "1_balanced.yaml",
-        "2_few_cutlery.yaml",
-        "3_few_waiters.yaml",
-        "4_few_cooks.yaml",
-        "5_less_ingredients.yaml",
-        "6_same_dish.yaml"
-    };
+int main(int argc, char *argv[]) {
+    // Tryb bez interakcji: Filozofowie_ZAAWANSOWANE --sweep sweep.yaml
+    if (argc >= 2 && std::string(argv[1]) == "--sweep") {
+        if (argc < 3) {
+            std::cerr << "Uzycie: " << argv[0] << " --sweep <plik_przegladu.yaml>\n";
+            return 1;
+        }
+        SweepConfig sweep;
+        if (!loadSweepConfig(argv[2], sweep)) return 1;
+        bool ok = runSweep(sweep);
+        LockProfiler::report(std::cout);
+        return ok ? 0 : 1;
+    }
+
+    const auto &configFiles = scenarioFiles();
 
     std::cout << "Wybierz scenariusz testowy:\n";
     for (size_t i = 0; i < configFiles.size(); ++i) {
@@ -45,103 +46,42 @@ int main() {
     int repeatCount = 1;
     std::cin >> repeatCount;
 
-    for (int sim = 1; sim <= repeatCount; ++sim) {
-        std::cout << "\nSymulacja nr " << sim << "...\n";
-
-        ConfigLoader loader;
-        if (!loader.loadFromFile(selectedFile)) {
-            std::cerr << "Bląd podczas wczytywania pliku konfiguracyjnego." << std::endl;
-            return 1;
-        }
-
-        auto philosophersCfg = loader.getPhilosophers();
-        auto cooksCfg = loader.getCooks();
-        auto pantry = loader.getPantry();
-        auto dishesCfg = loader.getDishes();
-        int waiterCount = loader.getWaiterCount();
-
-        auto kitchen = std::make_shared<Kitchen>();
-        for (const auto &[name, amount]: pantry.ingredients)
-            kitchen->addIngredient(name, amount);
-        for (const auto &[type, amount]: pantry.cutlery)
-            kitchen->addCutlery(type, amount);
-        for (const auto &[dishName, info]: dishesCfg)
-            kitchen->addDish(dishName, Kitchen::DishInfo{info.ingredient, info.cutlery, info.cookTimeMs, info.price});
-
-        std::vector<std::unique_ptr<Philosopher> > philosophers;
-        for (const auto &ph: philosophersCfg) {
-            auto philosopher = std::make_unique<Philosopher>(ph.id, ph.name, ph.favoriteDish, kitchen);
-            philosophers.emplace_back(std::move(philosopher));
-        }
-
-        std::unordered_map<int, Philosopher *> philosopherMap;
-        for (auto &p: philosophers)
-            philosopherMap[p->getId()] = p.get();
-        std::mutex philosopherMapMutex;
-
-        kitchen->runDishwasher(6000, 1500);
-        kitchen->startIngredientDelivery(20000);
-
-        std::vector<std::unique_ptr<Waiter> > waiters;
-        for (int i = 0; i < waiterCount; ++i) {
-            auto waiter = std::make_unique<Waiter>(i);
-            waiter->setKitchen(kitchen.get());
-            waiter->setPhilosopherMap(philosopherMap, philosopherMapMutex);
-            waiter->start();
-            waiters.emplace_back(std::move(waiter));
-        }
-
-        std::vector<std::unique_ptr<Cook> > cooks;
-        for (const auto &cookCfg: cooksCfg) {
-            auto cook = std::make_unique<Cook>(cookCfg.id, cookCfg.specialtyDish, kitchen.get());
-            cook->start();
-            cooks.emplace_back(std::move(cook));
-        }
-
-        for (auto &philosopher: philosophers)
-            philosopher->start();
-
-        std::vector<Philosopher *> philosopherPtrs;
-        for (auto &p: philosophers) philosopherPtrs.push_back(p.get());
-        std::vector<Waiter *> waiterPtrs;
-        for (auto &w: waiters) waiterPtrs.push_back(w.get());
-        std::vector<Cook *> cookPtrs;
-        for (auto &c: cooks) cookPtrs.push_back(c.get());
-
-        Display display(philosopherPtrs, waiterPtrs, cookPtrs, kitchen);
-        display.start();
-
-        std::this_thread::sleep_for(std::chrono::seconds(600));
-
-        display.stop();
-        for (auto &philosopher: philosophers)
-            philosopher->stop();
-        for (auto &waiter: waiters)
-            waiter->stop();
-        for (auto &cook: cooks)
-            cook->stop();
-        kitchen->stopBackgroundTasks();
+    std::cout << "Tryb symulacji:\n";
+    std::cout << "1. Czas rzeczywisty (watki)\n";
+    std::cout << "2. Symulacja zdarzeniowa (wirtualny zegar)\n";
+    std::cout << "3. Zadania na puli watkow (M:N)\n";
+    std::cout << "Twoj wybor (1-3): ";
+    int modeChoice = 1;
+    std::cin >> modeChoice;
+    SimulationMode mode = SimulationMode::Threaded;
+    if (modeChoice == 2) mode = SimulationMode::EventDriven;
+    else if (modeChoice == 3) mode = SimulationMode::Tasks;
+
+    std::cout << "Liczba rownoleglych symulacji (0 = liczba rdzeni): ";
+    int parallel = 1;
+    std::cin >> parallel;
+
+    ConfigLoader loader;
+    if (!loader.loadFromFile(selectedFile)) {
+        std::cerr << "Bląd podczas wczytywania pliku konfiguracyjnego." << std::endl;
+        return 1;
+    }
 
-        // Zapis wyników
-        std::ofstream out(resultsFile, std::ios::app);
-        out << "Symulacja #" << sim << "\n";
-        out << "-------------------------------------\n";
+    // Podgląd stanu ma sens tylko dla pojedynczej symulacji w czasie rzeczywistym
+    bool showDisplay = (mode != SimulationMode::EventDriven && parallel == 1);
 
-        long long totalWait = 0;
-        for (auto &p: philosophers) {
-            long long waitTime = p->getTotalExtraWaitTime();
-            totalWait += waitTime;
-            out << "Filozof " << p->getName() << " - czas oczekiwania: " << waitTime << " s\n";
-        }
-
-        double averageWait = philosophers.empty() ? 0.0 : static_cast<double>(totalWait) / philosophers.size();
-        out << "Średni czas oczekiwania: " << averageWait << " s\n";
+    auto results = runReplications(repeatCount, parallel, [&](int index) {
+        int sim = index + 1;
+        std::cout << "\nSymulacja nr " << sim << "...\n";
+        return runSimulation(loader, mode, sim, showDisplay);
+    });
 
-        double revenue = kitchen->getIncome();
-        out << "Przychód restauracji: " << std::fixed << std::setprecision(2) << revenue << " zł\n\n";
-        out.close();
-    }
+    std::ofstream out(resultsFile, std::ios::app);
+    for (size_t i = 0; i < results.size(); ++i)
+        writeResults(out, static_cast<int>(i) + 1, results[i]);
+    out.close();
 
     std::cout << "\nZapisano wyniki do pliku: " << resultsFile << std::endl;
+    LockProfiler::report(std::cout);
     return 0;
 }
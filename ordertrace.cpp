@@ -0,0 +1,25 @@
+#include "ordertrace.h"
+
+void StageLatency::record(const OrderTimes &times) {
+    for (int i = 0; i < intervalCount; ++i) {
+        long long from = times.ms[i], to = times.ms[i + 1];
+        if (from >= 0 && to >= 0) intervals[i].record(to - from);
+    }
+}
+
+void StageLatency::merge(const StageLatency &other) {
+    for (int i = 0; i < intervalCount; ++i)
+        intervals[i].merge(other.intervals[i]);
+}
+
+const char *StageLatency::intervalName(int interval) {
+    static const char *names[intervalCount] = {
+        "Czekanie na kelnera",
+        "Przyjęcie zamówienia",
+        "Kolejka w kuchni",
+        "Gotowanie",
+        "Czekanie na wydanie",
+        "Donoszenie",
+    };
+    return interval >= 0 && interval < intervalCount ? names[interval] : "";
+}
@@ -0,0 +1,49 @@
+#ifndef ORDERTRACE_H
+#define ORDERTRACE_H
+
+#include <array>
+
+#include "latencyhistogram.h"
+
+// Etapy zamówienia w kolejności przejścia przez restaurację
+enum class OrderStage {
+    Requested, // filozof woła kelnera
+    PickedUp, // kelner przyjmuje zamówienie
+    Ordered, // zamówienie trafia do kuchni (addOrder)
+    CookStarted, // kucharz zaczyna gotować
+    Ready, // danie gotowe (markDishReady)
+    DeliveryStarted, // kelner odbiera danie z kuchni
+    Served, // danie na stole (receiveFood)
+    Count
+};
+
+constexpr int orderStageCount = static_cast<int>(OrderStage::Count);
+
+// Znaczniki czasu etapów w ms czasu symulacji; -1 = etap jeszcze nie nastąpił.
+// Wędrują razem z zamówieniem: zgłoszenie kelnera, kolejka kucharza, wydanie dania.
+struct OrderTimes {
+    OrderTimes() { ms.fill(-1); }
+
+    void mark(OrderStage stage, long long nowMs) { ms[static_cast<int>(stage)] = nowMs; }
+
+    long long at(OrderStage stage) const { return ms[static_cast<int>(stage)]; }
+
+    std::array<long long, orderStageCount> ms;
+};
+
+// Rozkład czasu spędzonego między kolejnymi etapami; odcinek i trwa od etapu i do i + 1
+struct StageLatency {
+    static constexpr int intervalCount = orderStageCount - 1;
+
+    // Pomija odcinki, którym brakuje któregoś znacznika
+    void record(const OrderTimes &times);
+
+    void merge(const StageLatency &other);
+
+    // Nazwa odcinka do raportu
+    static const char *intervalName(int interval);
+
+    std::array<LatencyHistogram, intervalCount> intervals;
+};
+
+#endif // ORDERTRACE_H
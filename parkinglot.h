@@ -0,0 +1,157 @@
+#ifndef PARKINGLOT_H
+#define PARKINGLOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "profiledmutex.h"
+#include "scheduler.h"
+
+// Parkowanie konsumentów struktury z nieblokującym take(). Szybka ścieżka nie dotyka mutexu:
+// konsument bierze pracę sam, a producent sprawdza tylko licznik zaparkowanych.
+// Zaparkowany konsument (wątek albo korutyna z planistą) dostaje pracę do ręki: producent woła
+// za niego jego własne take(), więc każdy konsument może mieć inną kolejkę.
+template<typename T>
+class ParkingLot {
+public:
+    using Take = std::function<std::optional<T>()>;
+
+    // sharedWork: wszyscy konsumenci widzą tę samą pracę, więc pierwsze puste take() kończy
+    // rozdawanie. Bez tego (np. kelnerzy ze strefami) notify pyta każdego zaparkowanego.
+    // lockName: nazwa mutexu w profilu blokad
+    explicit ParkingLot(bool sharedWork = true, const char *lockName = "parkingLot")
+        : mutex(lockName), sharedWork(sharedWork) {
+    }
+
+    class Awaiter {
+    public:
+        Awaiter(ParkingLot &lot, TaskScheduler *scheduler, Take take, int tag)
+            : lot(lot), scheduler(scheduler), take(std::move(take)), tag(tag) {
+        }
+
+        bool await_ready() {
+            result = take();
+            if (result) return true;
+            if (scheduler) return false;
+
+            // Tryb wątkowy: blokujemy wątek do przekazania pracy albo zamknięcia
+            ProfiledUniqueLock lock(lot.mutex);
+            if (park(nullptr)) return true;
+            cv.wait(lock, [this] { return result.has_value() || lot.closed; });
+            return true;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<ProfiledMutex> lock(lot.mutex);
+            return !park(handle);
+        }
+
+        // Pusty wynik oznacza zamknięcie
+        std::optional<T> await_resume() { return std::move(result); }
+
+    private:
+        friend class ParkingLot;
+
+        // Wywoływane pod mutexem; true = praca lub zamknięcie, nie trzeba czekać
+        bool park(std::coroutine_handle<> handle) {
+            if (lot.closed) return true;
+            lot.parked.push_back(this);
+            this->handle = handle;
+            lot.parkedCount.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Ponowna próba po zaparkowaniu: producent, który nas nie zauważył, zdążył już odłożyć pracę
+            result = take();
+            if (!result) return false;
+            lot.parked.pop_back();
+            lot.parkedCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        ParkingLot &lot;
+        TaskScheduler *scheduler;
+        Take take;
+        int tag; // numer konsumenta dla notify(preferred)
+        std::optional<T> result;
+        std::coroutine_handle<> handle;
+        ProfiledConditionVariable cv;
+    };
+
+    Awaiter wait(TaskScheduler *scheduler, Take take, int tag = -1) {
+        return Awaiter(*this, scheduler, std::move(take), tag);
+    }
+
+    // Wołane przez producenta po udostępnieniu pracy; rozdaje ją zaparkowanym konsumentom,
+    // zaczynając od konsumenta z numerem preferred (jeśli czeka), potem w kolejności parkowania
+    void notify(int preferred = -1) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parkedCount.load(std::memory_order_relaxed) == 0) return;
+
+        std::vector<std::pair<std::coroutine_handle<>, TaskScheduler *> > toResume;
+        {
+            std::lock_guard<ProfiledMutex> lock(mutex);
+            if (preferred >= 0) {
+                auto it = std::find_if(parked.begin(), parked.end(),
+                                       [preferred](const Awaiter *a) { return a->tag == preferred; });
+                if (it != parked.end()) std::rotate(parked.begin(), it, it + 1);
+            }
+            for (auto it = parked.begin(); it != parked.end();) {
+                Awaiter *awaiter = *it;
+                auto item = awaiter->take();
+                if (!item) {
+                    if (sharedWork) break;
+                    ++it;
+                    continue;
+                }
+
+                it = parked.erase(it);
+                parkedCount.fetch_sub(1, std::memory_order_relaxed);
+                awaiter->result = std::move(item);
+                if (awaiter->handle) {
+                    toResume.emplace_back(awaiter->handle, awaiter->scheduler);
+                } else {
+                    // Pod mutexem: wątek nie zdąży zniszczyć awaitera przed powiadomieniem
+                    awaiter->cv.notify_one();
+                }
+            }
+        }
+        for (auto &[handle, scheduler]: toResume)
+            scheduler->post([handle] { handle.resume(); });
+    }
+
+    // Budzi wszystkich zaparkowanych z pustym wynikiem
+    void close() {
+        std::vector<std::pair<std::coroutine_handle<>, TaskScheduler *> > toResume;
+        {
+            std::lock_guard<ProfiledMutex> lock(mutex);
+            closed = true;
+            for (Awaiter *awaiter: parked) {
+                if (awaiter->handle)
+                    toResume.emplace_back(awaiter->handle, awaiter->scheduler);
+                else
+                    awaiter->cv.notify_one();
+            }
+            parked.clear();
+            parkedCount.store(0, std::memory_order_relaxed);
+        }
+        for (auto &[handle, scheduler]: toResume)
+            scheduler->post([handle] { handle.resume(); });
+    }
+
+private:
+    ProfiledMutex mutex;
+    std::deque<Awaiter *> parked;
+    std::atomic<int> parkedCount{0};
+    bool sharedWork;
+    bool closed = false;
+};
+
+#endif // PARKINGLOT_H
@@ -2,76 +2,136 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
-#include <cstdlib>
-#include <random>
 
-Philosopher::Philosopher(int id, const std::string &name, const std::string &favoriteDish,
-                         std::shared_ptr<Kitchen> kitchen)
-    : id(id), name(name), favoriteDish(favoriteDish), kitchen(kitchen), currentState(State::Thinking),
-      running(true), wantsToOrder(false), foodReady(false), orderTaken(false) {
+Philosopher::Philosopher(int id, const std::string &name, DishId favoriteDish,
+                         std::shared_ptr<Kitchen> kitchen, std::shared_ptr<Clock> clock, unsigned int seed)
+    : id(id), name(name), favoriteDish(favoriteDish), mealLatency(kitchen->getCatalog().dishes.size()),
+      currentState(State::Thinking), running(true), wantsToOrder(false),
+      kitchen(kitchen), clock(clock), gen(seed) {
 }
 
 Philosopher::~Philosopher() {
     stop();
-    if (thread.joinable()) thread.join();
+    join();
 }
 
 void Philosopher::start() {
     running = true;
-    thread = std::thread(&Philosopher::lifeCycle, this);
+    // Na własnym wątku korutyna nigdy się nie zawiesza: Sleep i Signal blokują wątek
+    thread = std::thread([this] {
+        task = lifeCycle();
+        task.resume();
+    });
+}
+
+void Philosopher::startTask(TaskScheduler *taskScheduler) {
+    running = true;
+    scheduler = taskScheduler;
+    task = lifeCycle();
+    scheduler->post([this] { task.resume(); });
 }
 
 void Philosopher::stop() {
     running = false;
 
-    // Obudź filozofa jeśli czeka na kelnera, żeby nie wisiał na wait()
-    {
-        std::lock_guard<std::mutex> lock(waiterMutex);
-        orderTaken = true;
+    // Obudź filozofa jeśli czeka na kelnera albo na danie, żeby nie wisiał na wait()
+    orderTakenSignal.set();
+    foodSignal.set();
+}
+
+void Philosopher::join() {
+    if (thread.joinable()) thread.join();
+}
+
+void Philosopher::setTracer(Tracer *tracer) {
+    this->tracer = tracer;
+}
+
+static const char *stateName(Philosopher::State state) {
+    switch (state) {
+        case Philosopher::State::Thinking: return "Thinking";
+        case Philosopher::State::Hungry: return "Hungry";
+        case Philosopher::State::Ordering: return "Ordering";
+        case Philosopher::State::Waiting: return "Waiting";
+        case Philosopher::State::Eating: return "Eating";
+        case Philosopher::State::Paying: return "Paying";
     }
-    waiterCondition.notify_one();
+    return "";
 }
 
-void Philosopher::lifeCycle() {
+void Philosopher::setState(State state) {
+    currentState = state;
+    if (tracer) tracer->state(Tracer::philosopherTrack(id), stateName(state), clock->now().count());
+}
+
+AgentTask Philosopher::lifeCycle() {
     while (running) {
-        think();
-        getHungry();
-        orderFood();
+        // think
+        setState(State::Thinking);
+        co_await sleepMs(randomDelayMs(1000, 3000));
+
+        // getHungry
+        setState(State::Hungry);
+        co_await sleepMs(500);
+
+        // orderFood
+        setState(State::Ordering);
+        DishId chosenDish = chooseDish();
+        orderTakenSignal.reset();
+        foodSignal.reset();
+        {
+            std::lock_guard<ProfiledMutex> lock(stateMutex);
+            currentOrder = chosenDish;
+            wantsToOrder = true;
+        }
+        {
+            auto menu = kitchen->getMenu();
+            const auto *dish = menu->find(chosenDish);
+            currentDishCookTimeMs = dish ? dish->cookTimeMs : 0;
+        }
+        OrderTimes times;
+        times.mark(OrderStage::Requested, clock->nowMs());
+        kitchen->getServiceQueue().requestOrder(id, times); // wołamy kelnera
+
+        // Czekaj na kelnera (markOrderTaken)
         if (!running) break;
-        waitForFood();
+        co_await orderTakenSignal.wait(scheduler);
         if (!running) break;
-        eat();
-        pay();
-    }
-}
 
-void Philosopher::think() {
-    currentState = State::Thinking;
-    std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 3000 + 1000));
-}
+        // waitForFood: budzi nas dokładnie raz receiveFood() kelnera
+        setState(State::Waiting);
+        co_await foodSignal.wait(scheduler);
+        if (!running) break;
+
+        // eat
+        setState(State::Eating);
+        co_await sleepMs(randomDelayMs(1000, 3000));
+        returnCutlery();
 
-void Philosopher::getHungry() {
-    currentState = State::Hungry;
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        // pay
+        setState(State::Paying);
+        payForMeal();
+        co_await sleepMs(500);
+    }
 }
 
-void Philosopher::orderFood() {
-    currentState = State::Ordering;
+Sleep Philosopher::sleepMs(int ms) {
+    return Sleep(*clock, scheduler, std::chrono::milliseconds(ms));
+}
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+DishId Philosopher::chooseDish() {
     std::uniform_real_distribution<> dis(0.0, 1.0);
 
-    std::string chosenDish;
+    DishId chosenDish;
 
     if (dis(gen) < 0.6) {
         chosenDish = favoriteDish;
     } else {
-        std::vector<std::string> allDishes;
+        std::vector<DishId> allDishes;
         auto menu = kitchen->getMenu();
-        for (const auto &pair : menu) {
-            if (pair.first != favoriteDish) {
-                allDishes.push_back(pair.first);
+        for (DishId dish = 0; dish < menu->size(); ++dish) {
+            if (dish != favoriteDish && menu->find(dish)) {
+                allDishes.push_back(dish);
             }
         }
         if (!allDishes.empty()) {
@@ -81,72 +141,59 @@ void Philosopher::orderFood() {
             chosenDish = favoriteDish;
         }
     }
-
-    {
-        std::lock_guard<std::mutex> lock(stateMutex);
-        currentOrder = chosenDish;
-        wantsToOrder = true;
-    }
-
-    // Czekaj na kelnera (orderTaken == true)
-    {
-        std::unique_lock<std::mutex> lock(waiterMutex);
-        orderTaken = false;
-        waiterCondition.wait(lock, [this] { return orderTaken || !running; });
-    }
-
-    if (!running) return;
-
-    wantsToOrder = false;
-
-    auto menu = kitchen->getMenu();
-    if (menu.count(currentOrder)) {
-        markOrderStart(menu.at(currentOrder).cookTimeMs / 1000.0);
-    }
-}
-
-void Philosopher::waitForFood() {
-    currentState = State::Waiting;
-    foodReady = false;
-    while (!foodReady && running) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    return chosenDish;
 }
 
-void Philosopher::eat() {
-    currentState = State::Eating;
-    std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 3000 + 1000));
-
-    std::string cutleryType;
+void Philosopher::returnCutlery() {
     auto menu = kitchen->getMenu();
-    if (menu.count(currentOrder)) {
-        cutleryType = menu.at(currentOrder).cutlery;
-    }
-
-    if (!cutleryType.empty()) {
-        kitchen->returnUsedCutlery(cutleryType);
+    if (const auto *dish = menu->find(currentOrder)) {
+        kitchen->returnUsedCutlery(*dish);
     }
 }
 
-void Philosopher::pay() {
-    currentState = State::Paying;
-
+void Philosopher::payForMeal() {
     double price = 0.0;
     auto menu = kitchen->getMenu();
-    if (menu.count(currentOrder)) {
-        price = menu.at(currentOrder).price;
+    if (const auto *dish = menu->find(currentOrder)) {
+        price = dish->price;
     }
 
     if (price > 0.0) {
         kitchen->addIncome(price);
     }
+}
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+std::optional<DishId> Philosopher::claimOrder() {
+    std::lock_guard<ProfiledMutex> lock(stateMutex);
+    if (!wantsToOrder) return std::nullopt;
+    wantsToOrder = false;
+    return currentOrder;
+}
+
+int Philosopher::randomDelayMs(int minMs, int rangeMs) {
+    std::uniform_int_distribution<int> dist(minMs, minMs + rangeMs - 1);
+    return dist(gen);
 }
 
-void Philosopher::receiveFood() {
-    foodReady = true;
-    markDishServed();
+void Philosopher::receiveFood(const OrderTimes &times) {
+    markDishServed(times);
+    foodSignal.set();
+}
+
+void Philosopher::markDishServed(OrderTimes times) {
+    long long servedMs = clock->nowMs();
+    times.mark(OrderStage::Served, servedMs);
+    stageLatency.record(times);
+
+    // Oczekiwanie liczymy od przekazania zamówienia do kuchni
+    long long orderedMs = times.at(OrderStage::Ordered);
+    if (orderedMs < 0) return;
+    long long waitMs = servedMs - orderedMs;
+    double extra = waitMs / 1000.0 - currentDishCookTimeMs / 1000.0;
+    if (extra > 0)
+        totalExtraWaitTime += extra;
+    if (currentOrder >= 0 && currentOrder < static_cast<int>(mealLatency.size()))
+        mealLatency[currentOrder].record(waitMs);
 }
 
 Philosopher::State Philosopher::getState() const {
@@ -161,25 +208,11 @@ int Philosopher::getId() const {
     return id;
 }
 
-bool Philosopher::isWaitingToOrder() {
-    std::lock_guard<std::mutex> lock(stateMutex);
-    return wantsToOrder;
-}
-
 std::string Philosopher::getCurrentOrder() {
-    std::lock_guard<std::mutex> lock(stateMutex);
-    return currentOrder;
+    std::lock_guard<ProfiledMutex> lock(stateMutex);
+    return kitchen->getCatalog().dishes.name(currentOrder);
 }
 
 void Philosopher::markOrderTaken() {
-    {
-        std::lock_guard<std::mutex> lock(waiterMutex);
-        orderTaken = true;
-    }
-    waiterCondition.notify_one();
-}
-
-void Philosopher::markOrderStart(double cookTimeSeconds) {
-    orderStartTime = std::chrono::steady_clock::now();
-    currentDishCookTime = cookTimeSeconds;
+    orderTakenSignal.set();
 }
@@ -1,54 +1,60 @@
 #pragma once
-#include <condition_variable>
 #include <string>
 #include <thread>
 #include <mutex>
 #include <vector>
 #include <memory>
+#include <random>
+#include <optional>
 #include "Kitchen.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "agenttask.h"
+#include "latencyhistogram.h"
+#include "ordertrace.h"
+#include "tracer.h"
+#include "profiledmutex.h"
 
 class Philosopher {
 public:
     enum class State { Thinking, Hungry, Ordering, Waiting, Eating, Paying };
 
-    Philosopher(int id, const std::string &name, const std::string &favoriteDish, std::shared_ptr<Kitchen> kitchen);
+    Philosopher(int id, const std::string &name, DishId favoriteDish, std::shared_ptr<Kitchen> kitchen,
+                std::shared_ptr<Clock> clock, unsigned int seed);
 
     ~Philosopher();
 
     void start();
 
+    // Tylko sygnał końca i pobudka z czekania na kelnera lub danie
     void stop();
 
-    void receiveFood();
+    // Czeka na koniec wątku filozofa (tryb wątkowy)
+    void join();
 
-    void markOrderTime() {
-        orderTime = std::chrono::steady_clock::now();
-    }
+    // Tryb M:N: korutyna cyklu życia wznawiana na puli planisty zamiast na własnym wątku
+    void startTask(TaskScheduler *taskScheduler);
 
-    void recordWaitTime(double cookTimeSeconds) {
-        auto now = std::chrono::steady_clock::now();
-        std::chrono::duration<double> waitDuration = now - orderTime;
-        double extraWait = waitDuration.count() - cookTimeSeconds;
-        if (extraWait > 0)
-            totalExtraWaitTime += extraWait;
-    }
+    void receiveFood(const OrderTimes &times);
+
+    // Zmiany stanu trafiają do zapisu przebiegu; tylko przed startem
+    void setTracer(Tracer *tracer);
 
     double getTotalExtraWaitTime() const {
         return totalExtraWaitTime;
     }
 
-    void markOrderStart(int cookTime) {
-        orderStartTime = std::chrono::steady_clock::now();
-        currentDishCookTime = cookTime;
+    // Danie na stole: zamyka znaczniki etapów zamówienia i zapisuje czasy oczekiwania
+    void markDishServed(OrderTimes times);
+
+    // Czytać dopiero po join() filozofa i kelnerów: zapisuje kelner podający danie
+    const std::vector<LatencyHistogram> &getMealLatency() const {
+        return mealLatency;
     }
 
-    void markDishServed() {
-        auto now = std::chrono::steady_clock::now();
-        double waitSeconds = std::chrono::duration_cast<std::chrono::milliseconds>(now - orderStartTime).count() /
-                             1000.0;
-        double extra = waitSeconds - currentDishCookTime;
-        if (extra > 0)
-            totalExtraWaitTime += extra;
+    // Jak getMealLatency: dopiero po join() filozofa i kelnerów
+    const StageLatency &getStageLatency() const {
+        return stageLatency;
     }
 
     State getState() const;
@@ -57,56 +63,56 @@ public:
 
     int getId() const;
 
-    bool isWaitingToOrder();
-
+    // Nazwa zamówionego dania (do wyświetlania)
     std::string getCurrentOrder();
 
     void markOrderTaken();
 
-    void markOrderStart(double cookTimeSeconds);
-
-    static std::vector<std::string> availableDishes;
+    // Kelner przejmuje zamówienie; pusty wynik, jeśli filozof nie czeka lub ktoś był szybszy
+    std::optional<DishId> claimOrder();
 
-    std::chrono::steady_clock::time_point orderTime;
     double totalExtraWaitTime = 0.0;
 
 private:
-    void lifeCycle();
+    // think -> getHungry -> orderFood -> waitForFood -> eat -> pay
+    AgentTask lifeCycle();
 
-    void think();
+    void setState(State state);
 
-    void getHungry();
+    Sleep sleepMs(int ms);
 
-    void orderFood();
+    DishId chooseDish();
 
-    void waitForFood();
+    void returnCutlery();
 
-    void eat();
+    void payForMeal();
 
-    void pay();
+    int randomDelayMs(int minMs, int rangeMs);
 
-    std::chrono::steady_clock::time_point orderStartTime;
-    int currentDishCookTime = 0; // w sekundach
+    int currentDishCookTimeMs = 0;
 
     int id;
     std::string name;
-    std::string favoriteDish;
-    std::string currentOrder;
+    DishId favoriteDish;
+    DishId currentOrder = -1;
 
-    std::chrono::steady_clock::time_point orderRequestTime;
-
-    double totalWaitTime = 0.0;
-    std::condition_variable waiterCondition;
-    std::mutex waiterMutex;
-    bool orderTaken = false;
+    std::vector<LatencyHistogram> mealLatency; // indeks = DishId
+    StageLatency stageLatency;
+    Signal orderTakenSignal;
+    Signal foodSignal; // ustawia kelner w receiveFood()
 
     State currentState;
     std::thread thread;
-    std::mutex stateMutex;
+    ProfiledMutex stateMutex{"philosopher.state"};
 
     bool running;
     bool wantsToOrder = false;
-    bool foodReady = false;
 
     std::shared_ptr<Kitchen> kitchen;
+    std::shared_ptr<Clock> clock;
+    std::mt19937 gen; // własny strumień losowy filozofa
+
+    TaskScheduler *scheduler = nullptr; // nullptr = własny wątek
+    AgentTask task;
+    Tracer *tracer = nullptr;
 };
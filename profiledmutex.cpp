@@ -0,0 +1,61 @@
+#include "profiledmutex.h"
+
+#ifdef PROFILE_LOCKS
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Liczniki żyją do końca programu, więc mutexy mogą trzymać do nich zwykły wskaźnik
+static std::mutex registryMutex;
+
+static std::map<std::string, std::unique_ptr<LockStats> > &registry() {
+    static std::map<std::string, std::unique_ptr<LockStats> > locks;
+    return locks;
+}
+
+static LockStats *statsFor(const char *name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &stats = registry()[name];
+    if (!stats) stats = std::make_unique<LockStats>();
+    return stats.get();
+}
+
+ProfiledMutex::ProfiledMutex(const char *name) : stats(statsFor(name)) {
+}
+
+void LockProfiler::report(std::ostream &out) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::vector<std::pair<std::string, const LockStats *> > locks;
+    for (const auto &[name, stats]: registry()) locks.emplace_back(name, stats.get());
+    std::sort(locks.begin(), locks.end(), [](const auto &a, const auto &b) {
+        return a.second->waitNs.load() > b.second->waitNs.load();
+    });
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << "\nRywalizacja o blokady:\n";
+    out << std::left << std::setw(24) << "blokada" << std::right << std::setw(12) << "przejecia"
+            << std::setw(12) << "z czekaniem" << std::setw(14) << "czekanie ms" << std::setw(14) << "trzymanie ms"
+            << std::setw(14) << "sr. czek. ns" << "\n";
+    for (const auto &[name, stats]: locks) {
+        long long acquisitions = stats->acquisitions.load();
+        long long contended = stats->contended.load();
+        long long waitNs = stats->waitNs.load();
+        out << std::left << std::setw(24) << name << std::right << std::setw(12) << acquisitions
+                << std::setw(12) << contended << std::setw(14) << std::fixed << std::setprecision(2) << waitNs / 1e6
+                << std::setw(14) << stats->holdNs.load() / 1e6
+                << std::setw(14) << std::setprecision(0) << (contended > 0 ? static_cast<double>(waitNs) / contended : 0.0)
+                << "\n";
+    }
+    out.flags(flags);
+}
+
+#else
+
+void LockProfiler::report(std::ostream &) {
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef PROFILEDMUTEX_H
+#define PROFILEDMUTEX_H
+
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+
+// Mutex z nazwą do profilowania rywalizacji o blokady. Bez PROFILE_LOCKS to zwykły std::mutex
+// (nazwa jest pomijana, zero kosztu). Z PROFILE_LOCKS każda blokada liczy przejęcia, przejęcia
+// z czekaniem, czas czekania i czas trzymania; mutexy o tej samej nazwie (np. kolejki wszystkich
+// kucharzy) mają wspólne liczniki. Raport: LockProfiler::report na końcu programu.
+#ifdef PROFILE_LOCKS
+
+#include <atomic>
+#include <chrono>
+
+struct LockStats {
+    std::atomic<long long> acquisitions{0};
+    std::atomic<long long> contended{0};
+    std::atomic<long long> waitNs{0};
+    std::atomic<long long> holdNs{0};
+};
+
+class ProfiledMutex {
+public:
+    explicit ProfiledMutex(const char *name);
+
+    ProfiledMutex(const ProfiledMutex &) = delete;
+
+    ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+    void lock() {
+        if (!mutex.try_lock()) {
+            auto start = std::chrono::steady_clock::now();
+            mutex.lock();
+            auto waited = std::chrono::steady_clock::now() - start;
+            stats->contended.fetch_add(1, std::memory_order_relaxed);
+            stats->waitNs.fetch_add(std::chrono::nanoseconds(waited).count(), std::memory_order_relaxed);
+        }
+        acquired();
+    }
+
+    bool try_lock() {
+        if (!mutex.try_lock()) return false;
+        acquired();
+        return true;
+    }
+
+    void unlock() {
+        auto held = std::chrono::steady_clock::now() - lockedAt;
+        stats->holdNs.fetch_add(std::chrono::nanoseconds(held).count(), std::memory_order_relaxed);
+        mutex.unlock();
+    }
+
+private:
+    void acquired() {
+        stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        lockedAt = std::chrono::steady_clock::now(); // pisze tylko właściciel blokady
+    }
+
+    std::mutex mutex;
+    LockStats *stats;
+    std::chrono::steady_clock::time_point lockedAt;
+};
+
+// Czekanie na warunek pod ProfiledMutex
+using ProfiledConditionVariable = std::condition_variable_any;
+using ProfiledUniqueLock = std::unique_lock<ProfiledMutex>;
+
+#else
+
+class ProfiledMutex : public std::mutex {
+public:
+    explicit ProfiledMutex(const char *) {
+    }
+};
+
+using ProfiledConditionVariable = std::condition_variable;
+using ProfiledUniqueLock = std::unique_lock<std::mutex>;
+
+#endif
+
+class LockProfiler {
+public:
+    static constexpr bool enabled =
+#ifdef PROFILE_LOCKS
+            true;
+#else
+            false;
+#endif
+
+    // Tabela blokad od najdłuższego łącznego czekania; bez PROFILE_LOCKS nic nie wypisuje
+    static void report(std::ostream &out);
+};
+
+#endif // PROFILEDMUTEX_H
@@ -0,0 +1,41 @@
+#include "replication.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+std::vector<SimulationResult> runReplications(int count, int maxParallel,
+                                              const std::function<SimulationResult(int)> &replication) {
+    std::vector<SimulationResult> results(std::max(count, 0));
+    if (count <= 0) return results;
+
+    if (maxParallel <= 0)
+        maxParallel = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int workerCount = std::min(maxParallel, count);
+
+    std::atomic<int> nextIndex = 0;
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        for (int i = nextIndex++; i < count; i = nextIndex++) {
+            try {
+                results[i] = replication(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) firstError = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < workerCount; ++w)
+        workers.emplace_back(worker);
+    worker();
+    for (auto &t: workers)
+        t.join();
+
+    if (firstError) std::rethrow_exception(firstError);
+    return results;
+}
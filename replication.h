@@ -0,0 +1,15 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include <functional>
+#include <vector>
+
+#include "results.h"
+
+// Uruchamia count niezależnych replikacji, najwyżej maxParallel naraz
+// (0 = liczba rdzeni). Wynik replikacji i trafia zawsze do slotu i,
+// więc kolejność wyników nie zależy od kolejności zakończenia.
+std::vector<SimulationResult> runReplications(int count, int maxParallel,
+                                              const std::function<SimulationResult(int)> &replication);
+
+#endif // REPLICATION_H
@@ -0,0 +1,33 @@
+#include "resourcestore.h"
+
+ResourceStore::ResourceStore(int count) : counters(std::make_unique<Counter[]>(count)), count(count) {
+}
+
+int ResourceStore::get(int id) const {
+    return counters[id].value.load(std::memory_order_acquire);
+}
+
+void ResourceStore::add(int id, int amount) {
+    counters[id].value.fetch_add(amount, std::memory_order_acq_rel);
+}
+
+bool ResourceStore::tryTake(int id, int amount) {
+    std::atomic<int> &value = counters[id].value;
+    int current = value.load(std::memory_order_acquire);
+    while (current >= amount) {
+        if (value.compare_exchange_weak(current, current - amount, std::memory_order_acq_rel))
+            return true;
+    }
+    return false;
+}
+
+int ResourceStore::takeAll(int id) {
+    return counters[id].value.exchange(0, std::memory_order_acq_rel);
+}
+
+std::vector<int> ResourceStore::snapshot() const {
+    std::vector<int> values(count);
+    for (int id = 0; id < count; ++id)
+        values[id] = get(id);
+    return values;
+}
@@ -0,0 +1,39 @@
+#ifndef RESOURCESTORE_H
+#define RESOURCESTORE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Liczniki zasobów (składniki, sztućce) na atomikach, indeksowane numerem z katalogu.
+// Rezerwacja to compare-and-swap, który nigdy nie schodzi poniżej zera; uzupełnianie to fetch_add.
+class ResourceStore {
+public:
+    explicit ResourceStore(int count = 0);
+
+    int size() const { return count; }
+
+    int get(int id) const;
+
+    void add(int id, int amount);
+
+    // Zdejmuje amount sztuk, jeśli tyle jest
+    bool tryTake(int id, int amount = 1);
+
+    // Zdejmuje wszystko (np. brudne sztućce do zmywarki) i zwraca, ile było
+    int takeAll(int id);
+
+    // Odczyt wszystkich liczników do wyświetlania
+    std::vector<int> snapshot() const;
+
+private:
+    // Każdy licznik we własnej linii pamięci podręcznej: kucharze nie przeszkadzają sobie nawzajem
+    struct alignas(64) Counter {
+        std::atomic<int> value{0};
+    };
+
+    std::unique_ptr<Counter[]> counters;
+    int count = 0;
+};
+
+#endif // RESOURCESTORE_H
@@ -0,0 +1,73 @@
+#include "results.h"
+#include <iomanip>
+
+LatencyHistogram totalMealLatency(const SimulationResult &result) {
+    LatencyHistogram total;
+    for (const auto &p: result.philosophers) {
+        for (const auto &dish: p.mealLatency)
+            total.merge(dish);
+    }
+    return total;
+}
+
+static void writeLatency(std::ostream &out, const std::string &label, const LatencyHistogram &latency) {
+    out << "  " << label << ": n=" << latency.count() << " p50=" << latency.percentile(50)
+            << " p95=" << latency.percentile(95) << " p99=" << latency.percentile(99)
+            << " max=" << latency.max() << "\n";
+}
+
+void writeResults(std::ostream &out, int simNumber, const SimulationResult &result) {
+    out << "Symulacja #" << simNumber << "\n";
+    out << "-------------------------------------\n";
+
+    double totalWait = 0.0;
+    for (const auto &p: result.philosophers) {
+        totalWait += p.extraWaitTime;
+        out << "Filozof " << p.name << " - czas oczekiwania: " << p.extraWaitTime << " s\n";
+    }
+
+    double averageWait = result.philosophers.empty() ? 0.0 : totalWait / result.philosophers.size();
+    out << "Średni czas oczekiwania: " << averageWait << " s\n";
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "Przychód restauracji: " << std::fixed << std::setprecision(2) << result.income << " zł\n";
+    double specialtyShare = result.dishesCooked > 0 ? 100.0 * result.specialtyDishes / result.dishesCooked : 0.0;
+    out << "Dania specjalistów: " << result.specialtyDishes << "/" << result.dishesCooked << " ("
+            << std::setprecision(1) << specialtyShare << "%)\n";
+    out.flags(flags);
+    out.precision(precision);
+
+    out << "Opóźnienia posiłków od zamówienia do podania [ms]:\n";
+    writeLatency(out, "Wszystkie", totalMealLatency(result));
+    for (size_t dish = 0; dish < result.dishNames.size(); ++dish) {
+        LatencyHistogram latency;
+        for (const auto &p: result.philosophers) {
+            if (dish < p.mealLatency.size()) latency.merge(p.mealLatency[dish]);
+        }
+        if (latency.count() > 0) writeLatency(out, "Danie " + result.dishNames[dish], latency);
+    }
+    for (const auto &p: result.philosophers) {
+        LatencyHistogram latency;
+        for (const auto &dish: p.mealLatency)
+            latency.merge(dish);
+        writeLatency(out, "Filozof " + p.name, latency);
+    }
+
+    // Udział etapu = jego średni czas względem sumy średnich wszystkich etapów
+    double meanTotal = 0.0;
+    for (const auto &interval: result.stageLatency.intervals)
+        meanTotal += interval.mean();
+    out << "Etapy zamówienia [ms]:\n";
+    for (int i = 0; i < StageLatency::intervalCount; ++i) {
+        const LatencyHistogram &interval = result.stageLatency.intervals[i];
+        double share = meanTotal > 0.0 ? 100.0 * interval.mean() / meanTotal : 0.0;
+        out << "  " << StageLatency::intervalName(i) << ": n=" << interval.count()
+                << " p50=" << interval.percentile(50) << " p95=" << interval.percentile(95)
+                << " p99=" << interval.percentile(99) << " średnio=" << std::fixed << std::setprecision(0)
+                << interval.mean() << " (" << std::setprecision(1) << share << "%)\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+    out << "\n";
+}
@@ -0,0 +1,33 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "latencyhistogram.h"
+#include "ordertrace.h"
+
+struct PhilosopherResult {
+    std::string name;
+    double extraWaitTime; // w sekundach
+    std::vector<LatencyHistogram> mealLatency; // od zamówienia do podania; indeks = DishId
+};
+
+struct SimulationResult {
+    std::vector<PhilosopherResult> philosophers;
+    double income = 0.0;
+    int dishesCooked = 0;
+    int specialtyDishes = 0; // ugotowane przez specjalistę od danego dania
+    std::vector<std::string> dishNames; // indeks = DishId, do raportu opóźnień
+    StageLatency stageLatency; // wszystkie podane posiłki
+};
+
+// Opóźnienia posiłków wszystkich filozofów razem
+LatencyHistogram totalMealLatency(const SimulationResult &result);
+
+// Zapis wyników jednej symulacji w formacie plików wyniki_*.txt; percentyle opóźnień
+// posiłków łącznie, dla każdego dania i każdego filozofa oraz podział czasu na etapy zamówienia
+void writeResults(std::ostream &out, int simNumber, const SimulationResult &result);
+
+#endif // RESULTS_H
@@ -0,0 +1,86 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <iostream>
+
+TaskScheduler::TaskScheduler(int workerCount, std::shared_ptr<Clock> clock)
+    : workerCount(std::max(workerCount, 1)), clock(std::move(clock)) {
+}
+
+TaskScheduler::~TaskScheduler() {
+    stop();
+}
+
+void TaskScheduler::start() {
+    if (dynamic_cast<ManualClock *>(clock.get())) {
+        std::cerr << "Planista zadań nie działa z zegarem ręcznym (ManualClock)\n";
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) return;
+        running = true;
+    }
+    for (int i = 0; i < workerCount; ++i)
+        workers.emplace_back(&TaskScheduler::workerLoop, this);
+}
+
+void TaskScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+    for (auto &worker: workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    readyTasks.clear();
+    timers = {};
+}
+
+void TaskScheduler::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        readyTasks.push_back(std::move(task));
+    }
+    cv.notify_one();
+}
+
+void TaskScheduler::postAfter(Clock::Duration delay, Task task) {
+    Clock::Duration deadline = clock->now() + delay;
+    bool earliest;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        earliest = timers.empty() || deadline < timers.top().deadline;
+        timers.push(Timer{deadline, nextSeq++, std::move(task)});
+    }
+    // Nowy najbliższy termin: ktoś śpiący do późniejszego terminu musi się obudzić
+    if (earliest) cv.notify_one();
+}
+
+void TaskScheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        Clock::Duration now = clock->now();
+        while (!timers.empty() && timers.top().deadline <= now) {
+            readyTasks.push_back(std::move(const_cast<Timer &>(timers.top()).task));
+            timers.pop();
+        }
+
+        if (!readyTasks.empty()) {
+            Task task = std::move(readyTasks.front());
+            readyTasks.pop_front();
+            bool moreWork = !readyTasks.empty();
+            lock.unlock();
+            if (moreWork) cv.notify_one();
+            task();
+            lock.lock();
+        } else if (!timers.empty()) {
+            cv.wait_for(lock, clock->toRealTime(timers.top().deadline - now));
+        } else {
+            cv.wait(lock);
+        }
+    }
+}
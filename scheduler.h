@@ -0,0 +1,69 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "clock.h"
+
+// Planista M:N: lekkie zadania agentów wykonywane na stałej puli wątków.
+// Zamiast sleep_for agent zleca swój kolejny krok przez postAfter().
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    TaskScheduler(int workerCount, std::shared_ptr<Clock> clock);
+
+    ~TaskScheduler();
+
+    // Z ManualClock odmawia startu: terminy timerów nigdy by nie nadeszły
+    void start();
+
+    // Zatrzymuje wątki; niewykonane zadania i timery są porzucane
+    void stop();
+
+    void post(Task task);
+
+    void postAfter(Clock::Duration delay, Task task);
+
+    void postAfterMs(int ms, Task task) { postAfter(std::chrono::milliseconds(ms), std::move(task)); }
+
+    Clock &getClock() const { return *clock; }
+
+    int getWorkerCount() const { return workerCount; }
+
+private:
+    struct Timer {
+        Clock::Duration deadline;
+        unsigned long long seq;
+        Task task;
+    };
+
+    struct Later {
+        bool operator()(const Timer &a, const Timer &b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.seq > b.seq;
+        }
+    };
+
+    void workerLoop();
+
+    int workerCount;
+    std::shared_ptr<Clock> clock;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Task> readyTasks;
+    std::priority_queue<Timer, std::vector<Timer>, Later> timers;
+    unsigned long long nextSeq = 0;
+    bool running = false;
+
+    std::vector<std::thread> workers;
+};
+
+#endif // SCHEDULER_H
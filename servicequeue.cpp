@@ -0,0 +1,101 @@
+#include "servicequeue.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+ServiceQueue::ServiceQueue(size_t capacity) : capacity(capacity) {
+    zones.push_back(std::make_unique<Zone>(capacity));
+}
+
+void ServiceQueue::addPhilosopher(int philosopherId, int zone) {
+    if (zone < 0) zone = 0;
+    while (static_cast<int>(zones.size()) <= zone)
+        zones.push_back(std::make_unique<Zone>(capacity));
+    zoneOfPhilosopher[philosopherId] = zone;
+}
+
+int ServiceQueue::getZoneCount() const {
+    return static_cast<int>(zones.size());
+}
+
+ServiceArea ServiceQueue::areaFor(int waiter, int waiterCount, bool helpNeighbours) const {
+    ServiceArea area;
+    int zoneCount = getZoneCount();
+    if (waiterCount <= 0) return area;
+
+    if (waiterCount >= zoneCount) {
+        area.home.push_back(waiter % zoneCount);
+    } else {
+        for (int zone = waiter; zone < zoneCount; zone += waiterCount)
+            area.home.push_back(zone);
+    }
+
+    if (helpNeighbours) {
+        auto covered = [&area](int zone) {
+            return std::find(area.home.begin(), area.home.end(), zone) != area.home.end() ||
+                   std::find(area.neighbours.begin(), area.neighbours.end(), zone) != area.neighbours.end();
+        };
+        for (int zone: area.home) {
+            for (int neighbour: {zone - 1, zone + 1}) {
+                if (neighbour >= 0 && neighbour < zoneCount && !covered(neighbour))
+                    area.neighbours.push_back(neighbour);
+            }
+        }
+    }
+    return area;
+}
+
+int ServiceQueue::zoneOf(int philosopherId) const {
+    auto it = zoneOfPhilosopher.find(philosopherId);
+    return it != zoneOfPhilosopher.end() ? it->second : 0;
+}
+
+void ServiceQueue::requestOrder(int philosopherId, const OrderTimes &times) {
+    int zone = zoneOf(philosopherId);
+    push(zones[zone]->orders, ServiceRequest{ServiceRequest::Type::TakeOrder, philosopherId, -1, zone, times});
+}
+
+void ServiceQueue::dishReady(int philosopherId, DishId dish, const OrderTimes &times) {
+    int zone = zoneOf(philosopherId);
+    push(zones[zone]->deliveries, ServiceRequest{ServiceRequest::Type::DeliverDish, philosopherId, dish, zone, times});
+}
+
+void ServiceQueue::push(MpmcQueue<ServiceRequest> &ring, ServiceRequest request) {
+    // Pełny pierścień oznacza za małą pojemność; czekamy, aż kelnerzy zwolnią miejsce
+    while (!ring.tryPush(std::move(request)))
+        std::this_thread::yield();
+    waiters.notify();
+}
+
+std::optional<ServiceRequest> ServiceQueue::tryPopZones(const std::vector<int> &zoneIds) {
+    for (int zone: zoneIds) {
+        if (auto request = zones[zone]->orders.tryPop()) return request;
+    }
+    for (int zone: zoneIds) {
+        if (auto request = zones[zone]->deliveries.tryPop()) return request;
+    }
+    return std::nullopt;
+}
+
+std::optional<ServiceRequest> ServiceQueue::tryPop(const ServiceArea &area) {
+    if (auto request = tryPopZones(area.home)) return request;
+    return tryPopZones(area.neighbours);
+}
+
+std::vector<ServiceRequest> ServiceQueue::takeMore(ServiceRequest::Type type, int zone, int max) {
+    std::vector<ServiceRequest> taken;
+    if (zone < 0 || zone >= getZoneCount()) return taken;
+
+    MpmcQueue<ServiceRequest> &ring = type == ServiceRequest::Type::TakeOrder ? zones[zone]->orders
+                                                                             : zones[zone]->deliveries;
+    while (static_cast<int>(taken.size()) < max) {
+        auto request = ring.tryPop();
+        if (!request) break;
+        taken.push_back(*request);
+    }
+    return taken;
+}
+
+void ServiceQueue::close() {
+    waiters.close();
+}
@@ -0,0 +1,89 @@
+#ifndef SERVICEQUEUE_H
+#define SERVICEQUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog.h"
+#include "mpmcqueue.h"
+#include "ordertrace.h"
+#include "parkinglot.h"
+#include "scheduler.h"
+
+// Zgłoszenie dla kelnera: filozof chce złożyć zamówienie albo danie czeka na wydanie
+struct ServiceRequest {
+    enum class Type { TakeOrder, DeliverDish };
+
+    Type type;
+    int philosopherId;
+    DishId dishId = -1; // tylko dla DeliverDish
+    int zone = 0; // strefa stolika filozofa
+    OrderTimes times; // znaczniki etapów zamówienia, którego dotyczy zgłoszenie
+};
+
+// Strefy obsługiwane przez kelnera: najpierw własne, sąsiednie tylko gdy we własnych nic nie ma
+struct ServiceArea {
+    std::vector<int> home;
+    std::vector<int> neighbours;
+};
+
+// Kolejka pracy kelnerów podzielona na strefy sali. W każdej strefie zamówienia mają
+// pierwszeństwo przed wydawaniem dań. Zgłoszenia leżą w pierścieniach bez blokad; wolny kelner
+// czeka na next() bez odpytywania (blokuje wątek albo, z planistą, zawiesza korutynę)
+// i dostaje do ręki zgłoszenie ze swojego obszaru.
+class ServiceQueue {
+public:
+    // Każdy filozof ma naraz co najwyżej jedno zgłoszenie, więc pojemność = liczba filozofów wystarcza
+    explicit ServiceQueue(size_t capacity = 1024);
+
+    // Przypisanie filozofa do strefy, tylko przed startem agentów; pozostali należą do strefy 0
+    void addPhilosopher(int philosopherId, int zone);
+
+    int getZoneCount() const;
+
+    // Kelner waiter z waiterCount dostaje strefy po kolei (przy mniejszej liczbie kelnerów
+    // niż stref kilka na kelnera); helpNeighbours dokłada strefy sąsiednie
+    ServiceArea areaFor(int waiter, int waiterCount, bool helpNeighbours) const;
+
+    void requestOrder(int philosopherId, const OrderTimes &times = OrderTimes());
+
+    void dishReady(int philosopherId, DishId dish, const OrderTimes &times = OrderTimes());
+
+    // Pusty wynik oznacza zamkniętą kolejkę. area musi żyć do końca czekania.
+    ParkingLot<ServiceRequest>::Awaiter next(TaskScheduler *scheduler, const ServiceArea &area) {
+        return waiters.wait(scheduler, [this, &area] { return tryPop(area); });
+    }
+
+    std::optional<ServiceRequest> tryPop(const ServiceArea &area);
+
+    // Do max kolejnych zgłoszeń danego rodzaju z tej samej strefy na jeden kurs, bez czekania
+    std::vector<ServiceRequest> takeMore(ServiceRequest::Type type, int zone, int max);
+
+    // Budzi wszystkich czekających kelnerów z pustym wynikiem
+    void close();
+
+private:
+    struct Zone {
+        explicit Zone(size_t capacity) : orders(capacity), deliveries(capacity) {
+        }
+
+        MpmcQueue<ServiceRequest> orders;
+        MpmcQueue<ServiceRequest> deliveries;
+    };
+
+    int zoneOf(int philosopherId) const;
+
+    void push(MpmcQueue<ServiceRequest> &ring, ServiceRequest request);
+
+    std::optional<ServiceRequest> tryPopZones(const std::vector<int> &zoneIds);
+
+    size_t capacity;
+    std::vector<std::unique_ptr<Zone> > zones; // stałe po starcie agentów
+    std::unordered_map<int, int> zoneOfPhilosopher;
+    ParkingLot<ServiceRequest> waiters{false, "service.waiterParking"};
+};
+
+#endif // SERVICEQUEUE_H
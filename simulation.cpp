@@ -0,0 +1,247 @@
+#include "simulation.h"
+#include "Philosopher.h"
+#include "Waiter.h"
+#include "Cook.h"
+#include "Kitchen.h"
+#include "display.h"
+#include "eventsim.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+const std::vector<std::string> &scenarioFiles() {
+    static const std::vector<std::string> files = {
+        "1_balanced.yaml",
+        "2_few_cutlery.yaml",
+        "3_few_waiters.yaml",
+        "4_few_cooks.yaml",
+        "5_less_ingredients.yaml",
+        "6_same_dish.yaml"
+    };
+    return files;
+}
+
+unsigned int deriveSeed(unsigned int replicationSeed, int stream, int id) {
+    std::seed_seq seq{replicationSeed, static_cast<unsigned int>(stream), static_cast<unsigned int>(id)};
+    unsigned int seed;
+    seq.generate(&seed, &seed + 1);
+    return seed;
+}
+
+std::shared_ptr<Kitchen> buildKitchen(const ConfigLoader &config, std::shared_ptr<Clock> clock) {
+    auto catalog = config.getCatalog();
+    auto kitchen = std::make_shared<Kitchen>(catalog, std::move(clock), config.getPhilosophers().size());
+
+    auto pantry = config.getPantry();
+    for (const auto &[name, amount]: pantry.ingredients)
+        kitchen->addIngredient(catalog->ingredients.find(name), amount);
+    for (const auto &[type, amount]: pantry.cutlery)
+        kitchen->addCutlery(catalog->cutlery.find(type), amount);
+    for (const auto &[dishName, info]: config.getDishes()) {
+        Kitchen::DishInfo dish{{}, {}, info.cookTimeMs, info.price, info.maxBatch, info.batchPortionMs};
+        for (const auto &[name, amount]: info.ingredients)
+            dish.ingredients.push_back({catalog->ingredients.find(name), amount});
+        for (const auto &[type, amount]: info.cutlery)
+            dish.cutlery.push_back({catalog->cutlery.find(type), amount});
+        kitchen->addDish(catalog->dishes.find(dishName), std::move(dish));
+    }
+    for (const auto &ph: config.getPhilosophers())
+        kitchen->getServiceQueue().addPhilosopher(ph.id, ph.zone);
+    if (auto planner = makeDeliveryPlanner(config.getDelivery(), catalog->ingredients.size(),
+                                           config.getTiming().deliveryIntervalMs))
+        kitchen->setDeliveryPlanner(std::move(planner));
+    // Kolejka kucharza ma numer równy jego pozycji w konfiguracji
+    for (const auto &cookCfg: config.getCooks())
+        kitchen->registerCook(catalog->dishes.find(cookCfg.specialtyDish));
+    return kitchen;
+}
+
+// trace.json -> trace_<nr>.json: każda symulacja ma własny plik
+static std::string traceFileName(const std::string &file, unsigned int seed) {
+    std::string stem = file;
+    if (stem.size() > 5 && stem.compare(stem.size() - 5, 5, ".json") == 0) stem.resize(stem.size() - 5);
+    return stem + "_" + std::to_string(seed) + ".json";
+}
+
+// Agenci na własnych wątkach albo (tasks == true) jako zadania na wspólnej puli TaskScheduler
+static SimulationResult runAgentSimulation(const ConfigLoader &loader, unsigned int seed, bool showDisplay,
+                                           bool tasks) {
+    auto philosophersCfg = loader.getPhilosophers();
+    auto cooksCfg = loader.getCooks();
+    auto catalog = loader.getCatalog();
+    int waiterCount = loader.getWaiterCount();
+    WaiterConfig waiterConfig = loader.getWaiterConfig();
+    TimingConfig timing = loader.getTiming();
+    DishwasherConfig dishwasherConfig = loader.getDishwasher();
+    TraceConfig traceConfig = loader.getTrace();
+
+    // Żyje dłużej niż wszyscy agenci, którzy do niego piszą
+    std::unique_ptr<Tracer> tracer;
+    if (!traceConfig.file.empty()) tracer = std::make_unique<Tracer>(traceConfig.bufferEvents);
+
+    std::shared_ptr<Clock> clock;
+    if (timing.timeScale != 1.0)
+        clock = std::make_shared<ScaledClock>(timing.timeScale);
+    else
+        clock = std::make_shared<RealClock>();
+
+    std::unique_ptr<TaskScheduler> scheduler;
+    if (tasks) {
+        int workerCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        scheduler = std::make_unique<TaskScheduler>(workerCount, clock);
+        scheduler->start();
+    }
+
+    // W trybie wątkowym cykle zmywarki ciągłej odmierza osobny jednowątkowy planista
+    std::unique_ptr<TaskScheduler> dishwasherTimers;
+    if (!scheduler && dishwasherConfig.machines > 0) {
+        dishwasherTimers = std::make_unique<TaskScheduler>(1, clock);
+        dishwasherTimers->start();
+    }
+
+    auto kitchen = buildKitchen(loader, clock);
+    if (tracer) {
+        kitchen->setTracer(tracer.get());
+        tracer->nameTrack(Tracer::kitchenTrack, "Kuchnia");
+    }
+
+    std::vector<std::unique_ptr<Philosopher> > philosophers;
+    for (const auto &ph: philosophersCfg) {
+        auto philosopher = std::make_unique<Philosopher>(ph.id, ph.name, catalog->dishes.find(ph.favoriteDish), kitchen, clock,
+                                                         deriveSeed(seed, 0, ph.id));
+        if (tracer) {
+            philosopher->setTracer(tracer.get());
+            tracer->nameTrack(Tracer::philosopherTrack(ph.id), "Filozof " + ph.name);
+        }
+        philosophers.emplace_back(std::move(philosopher));
+    }
+
+    std::unordered_map<int, Philosopher *> philosopherMap;
+    for (auto &p: philosophers)
+        philosopherMap[p->getId()] = p.get();
+
+    if (dishwasherConfig.machines > 0) {
+        TaskScheduler *timers = scheduler ? scheduler.get() : dishwasherTimers.get();
+        kitchen->startDishwasher(dishwasherConfig, [timers](int delayMs, std::function<void()> action) {
+            timers->postAfterMs(delayMs, std::move(action));
+        });
+    } else if (scheduler) {
+        kitchen->runDishwasher(*scheduler, timing.dishwasherIntervalMs, timing.dishwasherDurationMs);
+    } else {
+        kitchen->runDishwasher(timing.dishwasherIntervalMs, timing.dishwasherDurationMs);
+    }
+    if (scheduler)
+        kitchen->startIngredientDelivery(*scheduler, timing.deliveryIntervalMs);
+    else
+        kitchen->startIngredientDelivery(timing.deliveryIntervalMs);
+
+    std::vector<std::unique_ptr<Waiter> > waiters;
+    for (int i = 0; i < waiterCount; ++i) {
+        auto waiter = std::make_unique<Waiter>(i, clock, deriveSeed(seed, 1, i));
+        waiter->setKitchen(kitchen.get());
+        waiter->setPhilosopherMap(philosopherMap);
+        waiter->setBatchPolicy(waiterConfig.maxBatch, waiterConfig.itemMs);
+        waiter->setServiceArea(kitchen->getServiceQueue().areaFor(i, waiterCount, waiterConfig.helpNeighbours));
+        if (tracer) {
+            waiter->setTracer(tracer.get());
+            tracer->nameTrack(Tracer::waiterTrack(i), "Kelner " + std::to_string(i));
+        }
+        if (scheduler) waiter->startTask(scheduler.get());
+        else waiter->start();
+        waiters.emplace_back(std::move(waiter));
+    }
+
+    std::vector<std::unique_ptr<Cook> > cooks;
+    for (const auto &cookCfg: cooksCfg) {
+        auto cook = std::make_unique<Cook>(cookCfg.id, static_cast<int>(cooks.size()),
+                                           catalog->dishes.find(cookCfg.specialtyDish), kitchen.get(), clock);
+        if (tracer) {
+            cook->setTracer(tracer.get());
+            tracer->nameTrack(Tracer::cookTrack(cookCfg.id), "Kucharz " + std::to_string(cookCfg.id));
+        }
+        if (scheduler) cook->startTask(scheduler.get());
+        else cook->start();
+        cooks.emplace_back(std::move(cook));
+    }
+
+    for (auto &philosopher: philosophers) {
+        if (scheduler) philosopher->startTask(scheduler.get());
+        else philosopher->start();
+    }
+
+    std::vector<Philosopher *> philosopherPtrs;
+    for (auto &p: philosophers) philosopherPtrs.push_back(p.get());
+    std::vector<Waiter *> waiterPtrs;
+    for (auto &w: waiters) waiterPtrs.push_back(w.get());
+    std::vector<Cook *> cookPtrs;
+    for (auto &c: cooks) cookPtrs.push_back(c.get());
+
+    Display display(philosopherPtrs, waiterPtrs, cookPtrs, kitchen);
+    if (showDisplay) display.start();
+
+    clock->sleepFor(std::chrono::seconds(timing.durationSeconds));
+
+    display.stop();
+    if (scheduler) scheduler->stop();
+    kitchen->getServiceQueue().close(); // budzi kelnerów czekających na zgłoszenia
+    kitchen->closeOrders(); // i kucharzy czekających na zamówienia
+    for (auto &philosopher: philosophers)
+        philosopher->stop();
+    for (auto &waiter: waiters)
+        waiter->stop();
+    for (auto &cook: cooks)
+        cook->stop();
+    // Kelnerzy zapisują czasy posiłków filozofów, a wszyscy agenci piszą do zapisu przebiegu:
+    // wyniki i plik przebiegu dopiero po zakończeniu wszystkich wątków
+    for (auto &waiter: waiters)
+        waiter->join();
+    for (auto &philosopher: philosophers)
+        philosopher->join();
+    kitchen->stopBackgroundTasks();
+    if (dishwasherTimers) dishwasherTimers->stop();
+
+    // Wszyscy piszący zatrzymani (agenci, zmywarka, dostawy): dopiero teraz odczyt pierścieni
+    if (tracer) {
+        std::string file = traceFileName(traceConfig.file, seed);
+        std::ofstream out(file);
+        if (out) {
+            long long dropped = tracer->writeJson(out, clock->now().count());
+            std::cout << "Zapisano przebieg do pliku: " << file;
+            if (dropped > 0) std::cout << " (nadpisane najstarsze zdarzenia: " << dropped << ")";
+            std::cout << std::endl;
+        } else {
+            std::cerr << "Nie można zapisać pliku " << file << std::endl;
+        }
+    }
+
+    SimulationResult result;
+    for (auto &p: philosophers) {
+        result.philosophers.push_back(PhilosopherResult{p->getName(), p->getTotalExtraWaitTime(), p->getMealLatency()});
+        result.stageLatency.merge(p->getStageLatency());
+    }
+    for (DishId dish = 0; dish < catalog->dishes.size(); ++dish)
+        result.dishNames.push_back(catalog->dishes.name(dish));
+    result.income = kitchen->getIncome();
+    result.dishesCooked = kitchen->getDishesTaken();
+    result.specialtyDishes = kitchen->getSpecialtyDishesTaken();
+    return result;
+}
+
+SimulationResult runSimulation(const ConfigLoader &config, SimulationMode mode, unsigned int seed,
+                               bool showDisplay) {
+    if (mode == SimulationMode::EventDriven) {
+        EventSimulation simulation(config, seed);
+        return simulation.run(config.getTiming());
+    }
+    return runAgentSimulation(config, seed, showDisplay, mode == SimulationMode::Tasks);
+}
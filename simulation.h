@@ -0,0 +1,31 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <string>
+#include <vector>
+
+#include "ConfigLoader.h"
+#include "clock.h"
+#include "kitchen.h"
+#include "results.h"
+
+enum class SimulationMode {
+    Threaded,    // wątek na agenta, czas rzeczywisty lub przyspieszony
+    EventDriven, // kalendarz zdarzeń z wirtualnym zegarem
+    Tasks        // agenci jako lekkie zadania na stałej puli wątków (M:N)
+};
+
+// Scenariusze testowe dostępne w menu i domyślnie w przeglądzie parametrów
+const std::vector<std::string> &scenarioFiles();
+
+// Niezależny strumień losowy dla agenta (rodzaj + id) w ramach jednej replikacji
+unsigned int deriveSeed(unsigned int replicationSeed, int stream, int id);
+
+// Kuchnia z menu, zapasami, kolejkami kucharzy i strefami sali z konfiguracji; nazwy zamieniane na numery z katalogu
+std::shared_ptr<Kitchen> buildKitchen(const ConfigLoader &config, std::shared_ptr<Clock> clock);
+
+// Jedna pełna symulacja na własnej kuchni, agentach i strumieniu losowym
+SimulationResult runSimulation(const ConfigLoader &config, SimulationMode mode, unsigned int seed,
+                               bool showDisplay);
+
+#endif // SIMULATION_H
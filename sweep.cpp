@@ -0,0 +1,226 @@
+#include "sweep.h"
+#include "replication.h"
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+bool loadSweepConfig(const std::string &filename, SweepConfig &sweep) {
+    try {
+        YAML::Node config = YAML::LoadFile(filename);
+
+        if (config["configs"]) {
+            for (const auto &file: config["configs"])
+                sweep.configFiles.push_back(file.as<std::string>());
+        } else {
+            sweep.configFiles = scenarioFiles();
+        }
+
+        if (config["mode"]) {
+            std::string mode = config["mode"].as<std::string>();
+            if (mode == "threaded") {
+                sweep.mode = SimulationMode::Threaded;
+            } else if (mode == "event") {
+                sweep.mode = SimulationMode::EventDriven;
+            } else if (mode == "tasks") {
+                sweep.mode = SimulationMode::Tasks;
+            } else {
+                std::cerr << "Nieznany tryb '" << mode << "' (dozwolone: event, threaded, tasks)\n";
+                return false;
+            }
+        }
+        if (config["replications"]) sweep.replications = config["replications"].as<int>();
+        if (config["parallel"]) sweep.parallel = config["parallel"].as<int>();
+        if (config["output"]) sweep.outputFile = config["output"].as<std::string>();
+
+        if (config["parameters"]) {
+            for (const auto &paramNode: config["parameters"]) {
+                SweepParameter param;
+                param.name = paramNode.first.as<std::string>();
+                const YAML::Node &range = paramNode.second;
+
+                if (range.IsSequence()) {
+                    for (const auto &value: range)
+                        param.values.push_back(value.as<int>());
+                } else if (range.IsMap()) {
+                    int from = range["from"].as<int>();
+                    int to = range["to"].as<int>();
+                    int step = range["step"] ? range["step"].as<int>() : 1;
+                    if (step <= 0) {
+                        std::cerr << "Krok parametru '" << param.name << "' musi byc dodatni\n";
+                        return false;
+                    }
+                    for (int v = from; v <= to; v += step)
+                        param.values.push_back(v);
+                } else {
+                    param.values.push_back(range.as<int>());
+                }
+
+                if (param.values.empty()) {
+                    std::cerr << "Parametr '" << param.name << "' nie ma zadnych wartosci\n";
+                    return false;
+                }
+                sweep.parameters.push_back(param);
+            }
+        }
+    } catch (const YAML::BadFile &e) {
+        std::cerr << "Nie można otworzyć pliku: " << e.what() << std::endl;
+        return false;
+    } catch (const YAML::Exception &e) {
+        std::cerr << "Błąd podczas parsowania YAML: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool applySweepParameter(ConfigLoader &config, const std::string &name, int value) {
+    auto startsWith = [&name](const std::string &prefix) { return name.rfind(prefix, 0) == 0; };
+
+    if (name == "waiters.count") {
+        config.setWaiterCount(value);
+        return true;
+    }
+    if (name == "delivery.leadTimeMs") {
+        config.setDeliveryLeadTime(value);
+        return true;
+    }
+    if (name == "dishwasher.machines") {
+        config.setDishwasherMachines(value);
+        return true;
+    }
+    if (name == "dishwasher.capacity") {
+        config.setDishwasherCapacity(value);
+        return true;
+    }
+    if (name == "waiters.maxBatch") {
+        config.setWaiterMaxBatch(value);
+        return true;
+    }
+    if (name == "cooks.count") {
+        config.setCookCount(value);
+        return true;
+    }
+    if (startsWith("cutlery.")) {
+        config.setCutleryAmount(name.substr(8), value);
+        return true;
+    }
+    if (startsWith("pantry.")) {
+        config.setIngredientAmount(name.substr(7), value);
+        return true;
+    }
+    // dishes.<danie>.<pole>: nazwa dania między prefiksem a sufiksem
+    auto dishName = [&name, &startsWith](const std::string &suffix, std::string &dish) {
+        if (!startsWith("dishes.") || name.size() <= 7 + suffix.size() ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+            return false;
+        dish = name.substr(7, name.size() - 7 - suffix.size());
+        return true;
+    };
+    std::string dish;
+    if (dishName(".cookTimeMs", dish))
+        return config.setCookTime(dish, value);
+    if (dishName(".maxBatch", dish))
+        return config.setMaxBatch(dish, value);
+    return false;
+}
+
+std::vector<std::vector<int> > expandGrid(const std::vector<SweepParameter> &parameters) {
+    std::vector<std::vector<int> > grid = {{}};
+    for (const auto &param: parameters) {
+        std::vector<std::vector<int> > expanded;
+        for (const auto &point: grid) {
+            for (int value: param.values) {
+                auto next = point;
+                next.push_back(value);
+                expanded.push_back(next);
+            }
+        }
+        grid = expanded;
+    }
+    return grid;
+}
+
+bool runSweep(const SweepConfig &sweep) {
+    auto grid = expandGrid(sweep.parameters);
+
+    // Wszystkie konfiguracje punktów siatki przygotowujemy z góry, żeby błędy wyszły przed startem
+    std::vector<ConfigLoader> configs;
+    std::vector<std::string> configNames;
+    std::vector<const std::vector<int> *> points;
+    for (const auto &file: sweep.configFiles) {
+        ConfigLoader base;
+        if (!base.loadFromFile(file)) {
+            std::cerr << "Bląd podczas wczytywania pliku konfiguracyjnego " << file << std::endl;
+            return false;
+        }
+        base.setTraceFile(""); // punkty siatki nadpisywałyby sobie pliki przebiegu
+        for (const auto &point: grid) {
+            ConfigLoader config = base;
+            for (size_t i = 0; i < point.size(); ++i) {
+                if (!applySweepParameter(config, sweep.parameters[i].name, point[i])) {
+                    std::cerr << "Nieznany parametr '" << sweep.parameters[i].name << "' dla " << file << "\n";
+                    return false;
+                }
+            }
+            configs.push_back(config);
+            configNames.push_back(file);
+            points.push_back(&point);
+        }
+    }
+
+    int replications = std::max(sweep.replications, 1);
+    int jobCount = static_cast<int>(configs.size()) * replications;
+    std::cout << "Przeglad: " << configs.size() << " punktow x " << replications << " powtorzen\n";
+
+    // Ziarno zależy tylko od numeru powtórzenia: wszystkie punkty dostają te same
+    // strumienie losowe, więc różnice między punktami wynikają z parametrów
+    auto results = runReplications(jobCount, sweep.parallel, [&](int job) {
+        int rep = job % replications;
+        return runSimulation(configs[job / replications], sweep.mode, rep + 1, false);
+    });
+
+    std::ofstream out(sweep.outputFile);
+    if (!out) {
+        std::cerr << "Nie można zapisać pliku " << sweep.outputFile << std::endl;
+        return false;
+    }
+
+    out << "config";
+    for (const auto &param: sweep.parameters)
+        out << ";" << param.name;
+    out << ";replications;avgExtraWait_s;maxExtraWait_s;income_zl;specialtyShare;p95Latency_s;p99Latency_s\n";
+
+    for (size_t c = 0; c < configs.size(); ++c) {
+        double waitSum = 0.0, waitMax = 0.0, incomeSum = 0.0;
+        int dishesCooked = 0, specialtyDishes = 0;
+        LatencyHistogram latency; // posiłki ze wszystkich replikacji razem
+        for (int rep = 0; rep < replications; ++rep) {
+            const auto &result = results[c * replications + rep];
+            latency.merge(totalMealLatency(result));
+            double total = 0.0;
+            for (const auto &p: result.philosophers) {
+                total += p.extraWaitTime;
+                waitMax = std::max(waitMax, p.extraWaitTime);
+            }
+            waitSum += result.philosophers.empty() ? 0.0 : total / result.philosophers.size();
+            incomeSum += result.income;
+            dishesCooked += result.dishesCooked;
+            specialtyDishes += result.specialtyDishes;
+        }
+
+        out << configNames[c];
+        for (int value: *points[c])
+            out << ";" << value;
+        out << ";" << replications
+            << ";" << waitSum / replications
+            << ";" << waitMax
+            << ";" << incomeSum / replications
+            << ";" << (dishesCooked > 0 ? static_cast<double>(specialtyDishes) / dishesCooked : 0.0)
+            << ";" << latency.percentile(95) / 1000.0
+            << ";" << latency.percentile(99) / 1000.0 << "\n";
+    }
+
+    std::cout << "Zapisano wyniki przegladu do pliku: " << sweep.outputFile << std::endl;
+    return true;
+}
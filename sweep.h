@@ -0,0 +1,38 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+
+#include "ConfigLoader.h"
+#include "simulation.h"
+
+// Jeden wymiar siatki, np. "waiters.count" = {1, 2, 3}
+struct SweepParameter {
+    std::string name;
+    std::vector<int> values;
+};
+
+struct SweepConfig {
+    std::vector<std::string> configFiles;
+    std::vector<SweepParameter> parameters;
+    SimulationMode mode = SimulationMode::EventDriven;
+    int replications = 1;
+    int parallel = 0; // 0 = liczba rdzeni
+    std::string outputFile = "wyniki_sweep.csv";
+};
+
+bool loadSweepConfig(const std::string &filename, SweepConfig &sweep);
+
+// Ustawia parametr siatki w konfiguracji:
+// waiters.count, waiters.maxBatch, cooks.count, cutlery.<typ>, pantry.<składnik>, dishes.<danie>.cookTimeMs,
+// dishes.<danie>.maxBatch, delivery.leadTimeMs, dishwasher.machines, dishwasher.capacity
+bool applySweepParameter(ConfigLoader &config, const std::string &name, int value);
+
+// Iloczyn kartezjański wartości wszystkich parametrów (pierwszy parametr zmienia się najwolniej)
+std::vector<std::vector<int> > expandGrid(const std::vector<SweepParameter> &parameters);
+
+// Uruchamia wszystkie punkty siatki dla wszystkich konfiguracji i zapisuje jedną tabelę wyników
+bool runSweep(const SweepConfig &sweep);
+
+#endif // SWEEP_H
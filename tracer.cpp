@@ -0,0 +1,133 @@
+#include "tracer.h"
+
+#include <algorithm>
+#include <bit>
+#include <map>
+
+static std::atomic<uint64_t> nextTracerId{1};
+
+Tracer::Tracer(int bufferEvents)
+    : capacity(std::bit_ceil(static_cast<size_t>(std::max(bufferEvents, 1)))),
+      tracerId(nextTracerId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+void Tracer::nameTrack(int track, std::string name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    trackNames[track] = std::move(name);
+}
+
+Tracer::Buffer &Tracer::localBuffer() {
+    // Ostatnio używany bufor wątku; zmienia się tylko przy równoległych symulacjach
+    thread_local uint64_t cachedTracer = 0;
+    thread_local Buffer *cachedBuffer = nullptr;
+    if (cachedTracer == tracerId) return *cachedBuffer;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &buffer = buffers[std::this_thread::get_id()];
+    if (!buffer) buffer = std::make_unique<Buffer>(capacity);
+    cachedTracer = tracerId;
+    cachedBuffer = buffer.get();
+    return *buffer;
+}
+
+void Tracer::record(const Event &event) {
+    Buffer &buffer = localBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head & (capacity - 1)] = event;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::state(int track, const char *name, long long timeUs) {
+    record(Event{timeUs, 0, name, nullptr, nullptr, track, 'S'});
+}
+
+void Tracer::instant(int track, const char *name, long long timeUs, const char *argName, const char *argValue) {
+    record(Event{timeUs, 0, name, argName, argValue, track, 'i'});
+}
+
+void Tracer::complete(int track, const char *name, long long startUs, long long durationUs) {
+    record(Event{startUs, durationUs, name, nullptr, nullptr, track, 'X'});
+}
+
+// Nazwy w tym projekcie nie zawierają znaków sterujących; wystarczy cudzysłów i ukośnik
+static void writeString(std::ostream &out, const std::string &text) {
+    out << '"';
+    for (char c: text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+long long Tracer::writeJson(std::ostream &out, long long endUs) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<Event> events;
+    long long dropped = 0;
+    for (auto &[thread, buffer]: buffers) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t count = std::min<uint64_t>(head, capacity);
+        dropped += static_cast<long long>(head - count);
+        for (uint64_t i = head - count; i < head; ++i)
+            events.push_back(buffer->events[i & (capacity - 1)]);
+    }
+    // Agent w trybie M:N zmienia wątki, więc jego stany leżą w różnych pierścieniach
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event &a, const Event &b) { return a.timeUs < b.timeUs; });
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto begin = [&out, &first](int track, const char *phase) {
+        out << (first ? "" : ",\n") << "{\"pid\":1,\"tid\":" << track << ",\"ph\":\"" << phase << "\"";
+        first = false;
+    };
+
+    for (const auto &[track, name]: std::map<int, std::string>(trackNames.begin(), trackNames.end())) {
+        begin(track, "M");
+        out << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        writeString(out, name);
+        out << "}}";
+    }
+
+    // Stan trwa do następnej zmiany na ścieżce albo do końca symulacji
+    std::unordered_map<int, const Event *> openState;
+    auto closeState = [&](int track, long long untilUs) {
+        auto it = openState.find(track);
+        if (it == openState.end()) return;
+        begin(track, "X");
+        out << ",\"name\":";
+        writeString(out, it->second->name);
+        out << ",\"ts\":" << it->second->timeUs << ",\"dur\":" << std::max(0LL, untilUs - it->second->timeUs) << "}";
+        openState.erase(it);
+    };
+
+    for (const auto &event: events) {
+        if (event.phase == 'S') {
+            closeState(event.track, event.timeUs);
+            openState[event.track] = &event;
+            continue;
+        }
+        begin(event.track, event.phase == 'X' ? "X" : "i");
+        out << ",\"name\":";
+        writeString(out, event.name);
+        out << ",\"ts\":" << event.timeUs;
+        if (event.phase == 'X') out << ",\"dur\":" << event.durationUs;
+        else out << ",\"s\":\"t\"";
+        if (event.argName) {
+            out << ",\"args\":{";
+            writeString(out, event.argName);
+            out << ":";
+            writeString(out, event.argValue ? event.argValue : "");
+            out << "}";
+        }
+        out << "}";
+    }
+    std::vector<int> open;
+    for (const auto &[track, event]: openState) open.push_back(track);
+    std::sort(open.begin(), open.end());
+    for (int track: open)
+        closeState(track, endUs);
+
+    out << "\n]}\n";
+    return dropped;
+}
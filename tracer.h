@@ -0,0 +1,79 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Zapis przebiegu symulacji do formatu Chrome trace (chrome://tracing, Perfetto).
+// Każdy wątek pisze do własnego pierścienia bez blokad; mutex tylko przy pierwszym zapisie
+// wątku. Przy przepełnieniu najstarsze zdarzenia są nadpisywane. Odczyt (writeJson) dopiero
+// po zatrzymaniu wszystkich piszących. Nazwy zdarzeń muszą żyć do zapisu pliku.
+class Tracer {
+public:
+    // Ścieżki na osi czasu: kuchnia i po jednej na agenta
+    static constexpr int kitchenTrack = 1;
+
+    static int philosopherTrack(int id) { return 1000 + id; }
+
+    static int waiterTrack(int id) { return 2000 + id; }
+
+    static int cookTrack(int id) { return 3000 + id; }
+
+    explicit Tracer(int bufferEvents = 65536);
+
+    // Nazwa ścieżki w przeglądarce; tylko przed startem agentów
+    void nameTrack(int track, std::string name);
+
+    // Nowy stan agenta; trwa do następnej zmiany na tej samej ścieżce
+    void state(int track, const char *name, long long timeUs);
+
+    // Zdarzenie chwilowe, opcjonalnie z jednym argumentem
+    void instant(int track, const char *name, long long timeUs, const char *argName = nullptr,
+                 const char *argValue = nullptr);
+
+    // Zdarzenie o znanym czasie trwania
+    void complete(int track, const char *name, long long startUs, long long durationUs);
+
+    // Stany otwarte na końcu kończą się w endUs; zwraca liczbę nadpisanych zdarzeń
+    long long writeJson(std::ostream &out, long long endUs);
+
+private:
+    struct Event {
+        long long timeUs;
+        long long durationUs; // tylko dla Complete
+        const char *name;
+        const char *argName;
+        const char *argValue;
+        int track;
+        char phase; // 'S' = stan, 'i' = chwilowe, 'X' = z czasem trwania
+    };
+
+    // Pierścień jednego wątku: jeden piszący, odczyt po jego zatrzymaniu
+    struct Buffer {
+        explicit Buffer(size_t capacity) : events(capacity) {
+        }
+
+        std::vector<Event> events;
+        std::atomic<uint64_t> head{0};
+    };
+
+    void record(const Event &event);
+
+    Buffer &localBuffer();
+
+    size_t capacity; // potęga dwójki
+    uint64_t tracerId; // odróżnia pamięć wątku od poprzednich Tracerów pod tym samym adresem
+
+    std::mutex mutex; // rejestracja buforów i nazw ścieżek
+    std::unordered_map<std::thread::id, std::unique_ptr<Buffer> > buffers;
+    std::unordered_map<int, std::string> trackNames;
+};
+
+#endif // TRACER_H
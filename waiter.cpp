@@ -1,108 +1,167 @@
 #include "Waiter.h"
 #include "Kitchen.h"
 #include "Philosopher.h"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <cstdlib>
+#include <utility>
+#include <vector>
 
-Waiter::Waiter(int id)
-    : id(id), servingPhilosopherId(-1), state(State::Free), running(false) {
+Waiter::Waiter(int id, std::shared_ptr<Clock> clock, unsigned int seed)
+    : id(id), servingPhilosopherId(-1), state(State::Free), running(false), clock(clock), gen(seed) {
 }
 
 Waiter::~Waiter() {
     stop();
-    if (thread.joinable()) thread.join();
+    join();
 }
 
 void Waiter::start() {
     running = true;
-    thread = std::thread(&Waiter::lifeCycle, this);
+    thread = std::thread([this] {
+        task = lifeCycle();
+        task.resume();
+    });
+}
+
+void Waiter::startTask(TaskScheduler *taskScheduler) {
+    running = true;
+    scheduler = taskScheduler;
+    task = lifeCycle();
+    scheduler->post([this] { task.resume(); });
 }
 
 void Waiter::stop() {
     running = false;
 }
 
+void Waiter::join() {
+    if (thread.joinable()) thread.join();
+}
+
 void Waiter::setKitchen(Kitchen *k) {
     kitchen = k;
 }
 
-void Waiter::setPhilosopherMap(std::unordered_map<int, Philosopher *> &map, std::mutex &mutex) {
-    philosopherMap = map;
-    philosopherMapMutex = &mutex;
+void Waiter::setPhilosopherMap(const std::unordered_map<int, Philosopher *> &map) {
+    philosopherMap = &map;
 }
 
-void Waiter::deliverOrderToKitchen(int philosopherId, const std::string &dish) {
-    if (kitchen) {
-        kitchen->addOrder(philosopherId, dish);
-    }
+void Waiter::setServiceArea(ServiceArea serviceArea) {
+    area = std::move(serviceArea);
 }
 
-void Waiter::lifeCycle() {
-    while (running) {
-        bool wasBusy = false;
-
-        // 1. Priorytet: obsługa filozofów czekających na kelnera (zamówienia)
-        {
-            std::lock_guard<std::mutex> lock(*philosopherMapMutex);
-            for (auto &[id, philosopher] : philosopherMap) {
-                if (philosopher && philosopher->isWaitingToOrder()) {
-                    std::string dish = philosopher->getCurrentOrder();
-
-                    state = State::Busy;
-                    servingPhilosopherId = id;
-
-                    std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 400 + 200));
+void Waiter::setBatchPolicy(int maxBatch, int itemMs) {
+    this->maxBatch = std::max(1, maxBatch);
+    this->itemMs = itemMs;
+}
 
-                    deliverOrderToKitchen(id, dish);
+void Waiter::setTracer(Tracer *tracer) {
+    this->tracer = tracer;
+}
 
-                    auto menu = kitchen->getMenu();
-                    if (menu.count(dish)) {
-                        double cookTime = menu.at(dish).cookTimeMs / 1000.0;
-                        philosopher->markOrderStart(cookTime);  // Kelner inicjuje gotowanie
-                    }
+void Waiter::setState(State newState, const char *traceName) {
+    state = newState;
+    if (tracer) tracer->state(Tracer::waiterTrack(id), traceName, clock->now().count());
+}
 
-                    philosopher->markOrderTaken();
+void Waiter::deliverOrderToKitchen(int philosopherId, DishId dish, const OrderTimes &times) {
+    if (kitchen) {
+        kitchen->addOrder(philosopherId, dish, times);
+    }
+}
 
-                    std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 400 + 200));
+int Waiter::randomDelayMs(int minMs, int rangeMs) {
+    std::uniform_int_distribution<int> dist(minMs, minMs + rangeMs - 1);
+    return dist(gen);
+}
 
-                    servingPhilosopherId = -1;
-                    state = State::Free;
+AgentTask Waiter::lifeCycle() {
+    ServiceQueue &queue = kitchen->getServiceQueue();
+    setState(State::Free, "Free");
 
-                    wasBusy = true;
-                    break;  // Obsłużono jednego filozofa, wracamy na początek pętli
+    while (running) {
+        // Czekamy na zgłoszenie (zamówienie ma pierwszeństwo przed gotowym daniem), bez odpytywania
+        // Najpierw własne strefy, potem sąsiednie
+        auto request = co_await queue.next(scheduler, area);
+        if (!request) break; // kolejka zamknięta, koniec symulacji
+
+        // Jeden kurs: pierwsze zgłoszenie i do maxBatch - 1 kolejnych tego samego rodzaju z tej samej strefy
+        std::vector<ServiceRequest> trip{*request};
+        for (const auto &more: queue.takeMore(request->type, request->zone, maxBatch - 1))
+            trip.push_back(more);
+
+        if (request->type == ServiceRequest::Type::TakeOrder) {
+            // Zamówienia przejmujemy atomowo: filozof mógł już zostać obsłużony
+            struct Claimed {
+                Philosopher *philosopher;
+                DishId dish;
+                OrderTimes times;
+            };
+            std::vector<Claimed> claimed;
+            long long pickedUpMs = clock->nowMs();
+            for (const auto &order: trip) {
+                Philosopher *philosopher = findPhilosopher(order.philosopherId);
+                if (!philosopher) continue;
+                if (auto dish = philosopher->claimOrder()) {
+                    claimed.push_back(Claimed{philosopher, *dish, order.times});
+                    claimed.back().times.mark(OrderStage::PickedUp, pickedUpMs);
                 }
             }
-        }
+            if (claimed.empty()) continue;
 
-        // 2. Jeśli nie obsłużono zamówienia (brak filozofów czekających), to sprawdź gotowe dania
-        if (!wasBusy && kitchen && kitchen->hasReadyDish()) {
-            auto readyOrder = kitchen->getReadyDish();
-            state = State::Busy;
-            servingPhilosopherId = readyOrder.first;
-            wasBusy = true;
+            setState(State::Busy, "Taking orders");
+            co_await sleepMs(randomDelayMs(200, 400));
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 400 + 200));
+            for (size_t i = 0; i < claimed.size(); ++i) {
+                auto &[philosopher, dish, times] = claimed[i];
+                if (i > 0) co_await sleepMs(itemMs);
+                servingPhilosopherId = philosopher->getId();
 
-            {
-                std::lock_guard<std::mutex> lock(*philosopherMapMutex);
-                if (philosopherMap.count(readyOrder.first)) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 500 + 300));
-                    philosopherMap[readyOrder.first]->receiveFood();
-                }
+                times.mark(OrderStage::Ordered, clock->nowMs());
+                deliverOrderToKitchen(philosopher->getId(), dish, times);
+                philosopher->markOrderTaken();
             }
 
-            servingPhilosopherId = -1;
-            state = State::Free;
+            co_await sleepMs(randomDelayMs(200, 400));
+        } else {
+            std::vector<std::pair<Philosopher *, OrderTimes> > recipients;
+            long long deliveryMs = clock->nowMs();
+            for (const auto &delivery: trip) {
+                if (Philosopher *philosopher = findPhilosopher(delivery.philosopherId)) {
+                    recipients.emplace_back(philosopher, delivery.times);
+                    recipients.back().second.mark(OrderStage::DeliveryStarted, deliveryMs);
+                }
+            }
+            if (recipients.empty()) continue;
+
+            setState(State::Busy, "Delivering");
+            servingPhilosopherId = recipients.front().first->getId();
+            co_await sleepMs(randomDelayMs(200, 400));
+            co_await sleepMs(randomDelayMs(300, 500));
+            for (size_t i = 0; i < recipients.size(); ++i) {
+                if (i > 0) co_await sleepMs(itemMs);
+                auto &[philosopher, times] = recipients[i];
+                servingPhilosopherId = philosopher->getId();
+                philosopher->receiveFood(times);
+            }
         }
 
-        // 3. Jeśli nic do roboty, odsapnij chwilę
-        if (!wasBusy) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(250));
-        }
+        servingPhilosopherId = -1;
+        setState(State::Free, "Free");
     }
 }
 
+Philosopher *Waiter::findPhilosopher(int philosopherId) {
+    // Mapa nie zmienia się po starcie, więc odczyt bez blokady
+    if (!philosopherMap) return nullptr;
+    auto it = philosopherMap->find(philosopherId);
+    return it != philosopherMap->end() ? it->second : nullptr;
+}
+
+Sleep Waiter::sleepMs(int ms) {
+    return Sleep(*clock, scheduler, std::chrono::milliseconds(ms));
+}
 
 Waiter::State Waiter::getState() const {
     return state;
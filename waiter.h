@@ -3,9 +3,16 @@
 
 #include <string>
 #include <thread>
-#include <mutex>
 #include <atomic>
 #include <unordered_map>
+#include <memory>
+#include <random>
+#include "catalog.h"
+#include "clock.h"
+#include "scheduler.h"
+#include "servicequeue.h"
+#include "agenttask.h"
+#include "tracer.h"
 
 class Kitchen;
 class Philosopher;
@@ -14,17 +21,34 @@ class Waiter {
 public:
     enum class State { Free, Busy };
 
-    Waiter(int id);
+    Waiter(int id, std::shared_ptr<Clock> clock, unsigned int seed);
 
     ~Waiter();
 
     void start();
 
+    // Tylko sygnał końca; wątek kończy się po zamknięciu kolejki zgłoszeń
     void stop();
 
+    // Czeka na koniec wątku kelnera (tryb wątkowy)
+    void join();
+
+    // Tryb M:N: korutyna obsługi wznawiana na puli planisty zamiast na własnym wątku
+    void startTask(TaskScheduler *taskScheduler);
+
     void setKitchen(Kitchen *kitchen);
 
-    void setPhilosopherMap(std::unordered_map<int, Philosopher *> &map, std::mutex &mutex);
+    // Wspólna mapa tylko do odczytu; musi żyć dłużej niż kelner
+    void setPhilosopherMap(const std::unordered_map<int, Philosopher *> &map);
+
+    // Do maxBatch zgłoszeń jednego rodzaju na kurs; itemMs za każde zgłoszenie ponad pierwsze
+    void setBatchPolicy(int maxBatch, int itemMs);
+
+    // Strefy sali obsługiwane przez kelnera (ServiceQueue::areaFor)
+    void setServiceArea(ServiceArea area);
+
+    // Zmiany stanu trafiają do zapisu przebiegu; tylko przed startem
+    void setTracer(Tracer *tracer);
 
     State getState() const;
 
@@ -40,12 +64,29 @@ public:
     std::thread thread;
 
     Kitchen *kitchen = nullptr;
-    std::unordered_map<int, Philosopher *> philosopherMap;
-    std::mutex *philosopherMapMutex = nullptr;
+    std::shared_ptr<Clock> clock;
+    std::mt19937 gen;
+    const std::unordered_map<int, Philosopher *> *philosopherMap = nullptr;
+    ServiceArea area{{0}, {}};
+    int maxBatch = 1;
+    int itemMs = 0;
+
+    TaskScheduler *scheduler = nullptr; // nullptr = własny wątek
+    AgentTask task;
+    Tracer *tracer = nullptr;
+
+    AgentTask lifeCycle();
+
+    // traceName: opis kursu w zapisie przebiegu
+    void setState(State newState, const char *traceName);
+
+    Sleep sleepMs(int ms);
+
+    Philosopher *findPhilosopher(int philosopherId);
 
-    void lifeCycle();
+    void deliverOrderToKitchen(int philosopherId, DishId dish, const OrderTimes &times);
 
-    void deliverOrderToKitchen(int philosopherId, const std::string &dish);
+    int randomDelayMs(int minMs, int rangeMs);
 };
 
 #endif // WAITER_H